@@ -0,0 +1,117 @@
+# stress_benchmark.py
+#
+# Generates stress maps over a wall/spawner matrix, soaks each one headless with bots
+# throwing, and merges the soak summaries into one table.
+#
+# python Scripts/stress_benchmark.py --engine "C:/UE_5.5/Engine/Binaries/Win64/UnrealEditor-Cmd.exe"
+#     [--walls 0 200 800] [--spawners 2 8 32] [--layout grid] [--targetrate 4] [--minutes 2] [--bots 4]
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROJECT_FILE = os.path.join(PROJECT_DIR, "SatJam_Boomerang.uproject")
+SETTINGS_SECTION = "/Script/SatJam_Boomerang.BoomerangSettings"
+
+# Columns copied from each SoakSummary, in table order
+COLUMNS = [
+    "Frames",
+    "FrameMsP50", "FrameMsP95", "FrameMsP99",
+    "GameThreadMsP50", "GameThreadMsP95",
+    "SweepMsP50", "SweepMsP95", "SweepsPerFrame",
+    "OverlapMsP50", "OverlapMsP95", "OverlapsPerFrame",
+    "PeakTargets", "PeakBoomerangs", "HitchCount",
+]
+
+
+def run(command):
+    print(" ".join(command), flush=True)
+    return subprocess.run(command).returncode
+
+
+def generate_map(args, package, walls, spawners):
+    return run([
+        args.engine, PROJECT_FILE, "-run=GenerateStressMap",
+        f"-output={package}", f"-walls={walls}", f"-spawners={spawners}",
+        f"-layout={args.layout}", f"-targetrate={args.targetrate}", f"-seed={args.seed}",
+        "-unattended", "-nopause", "-nosplash",
+    ])
+
+
+def soak_map(args, package, summary_path):
+    # Lift the director caps so target count follows the map, not the settings
+    return run([
+        args.engine, PROJECT_FILE, package, "-game", "-nullrhi", "-nosound", "-unattended",
+        "-soak", "-soakkeepspawnrate",
+        f"-soakminutes={args.minutes}", f"-soakbots={args.bots}", f"-soakseed={args.seed}",
+        f"-soaksummary={summary_path}",
+        f"-ini:Game:[{SETTINGS_SECTION}]:MaxLiveTargets=0",
+        f"-ini:Game:[{SETTINGS_SECTION}]:MaxSpawnsPerSecond=0",
+        f"-ini:Game:[{SETTINGS_SECTION}]:MaxSpawnsPerFrame=0",
+        f"-ini:Game:[{SETTINGS_SECTION}]:bEnableFrameBudgetGovernor=False",
+    ])
+
+
+def read_summary(path):
+    with open(path, newline="") as f:
+        return {row[0]: row[1] for row in csv.reader(f) if len(row) >= 2}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stress map benchmark matrix")
+    parser.add_argument("--engine", required=True, help="Path to UnrealEditor-Cmd")
+    parser.add_argument("--walls", type=int, nargs="+", default=[0, 200, 800])
+    parser.add_argument("--spawners", type=int, nargs="+", default=[2, 8, 32])
+    parser.add_argument("--layout", choices=["grid", "random"], default="grid")
+    parser.add_argument("--targetrate", type=float, default=4.0, help="Targets per second per 8 spawners")
+    parser.add_argument("--minutes", type=float, default=2.0)
+    parser.add_argument("--bots", type=int, default=4)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--output", default=os.path.join(PROJECT_DIR, "Saved", "Profiling", "StressBenchmark"))
+    parser.add_argument("--skip-generate", action="store_true", help="Reuse maps from a previous run")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    rows = []
+
+    for walls in args.walls:
+        for spawners in args.spawners:
+            name = f"Stress_{args.layout}_W{walls}_S{spawners}"
+            package = f"/Game/Benchmark/{name}"
+            summary_path = os.path.join(args.output, f"{name}.csv")
+
+            # Keep target density per spawner fixed so target count scales with spawners
+            rate = args.targetrate * spawners / 8.0
+
+            if not args.skip_generate:
+                args_for_map = argparse.Namespace(**vars(args))
+                args_for_map.targetrate = rate
+                if generate_map(args_for_map, package, walls, spawners) != 0:
+                    print(f"Failed to generate {package}", file=sys.stderr)
+                    continue
+
+            if os.path.exists(summary_path):
+                os.remove(summary_path)
+            soak_map(args, package, summary_path)
+            if not os.path.exists(summary_path):
+                print(f"No soak summary for {package}", file=sys.stderr)
+                continue
+
+            summary = read_summary(summary_path)
+            rows.append([args.layout, walls, spawners] + [summary.get(column, "") for column in COLUMNS])
+
+    table_path = os.path.join(args.output, "StressBenchmark.csv")
+    with open(table_path, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["Layout", "Walls", "Spawners"] + COLUMNS)
+        writer.writerows(rows)
+
+    print(f"Wrote {len(rows)} rows to {table_path}")
+    return 0 if rows else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,15 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Trajectory and hit-test math with no UObject or engine dependency,
+// shared by the game module and the BoomerangBench program
+public class BoomerangMath : ModuleRules
+{
+	public BoomerangMath(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
@@ -0,0 +1,128 @@
+// BoomerangAimSolver.cpp
+
+#include "BoomerangAimSolver.h"
+#include "BoomerangTrajectory.h"
+#include "Math/VectorRegister.h"
+
+
+void FBoomerangAimSolver::Initialize(float InDistance, float InCurveRadius, int32 InNumSegments, TConstArrayView<FVector3f> ShapeTable)
+{
+    const int32 NumSegments = FMath::Max(InNumSegments, 1);
+    NumVertices = NumSegments + 1;
+
+    const int32 NumPadded = Align(NumVertices, 4);
+    LocalForward.SetNumZeroed(NumPadded);
+    LocalSide.SetNumZeroed(NumPadded);
+    LocalUp.SetNumZeroed(NumPadded);
+    LocalRadiusSq.SetNumZeroed(NumPadded);
+
+    float MaxRadiusSq = 0.f;
+    for (int32 i = 0; i < NumVertices; ++i)
+    {
+        // Same curve as BuildPath, without the aim rotation
+        const float T = static_cast<float>(i) / NumSegments;
+        const FVector3f Local = ShapeTable.Num() >= 2
+            ? BoomerangMath::EvaluateTable(ShapeTable, T, InDistance, InCurveRadius)
+            : FVector3f(BoomerangMath::EvaluateLocal(T, InDistance, InCurveRadius), 0.f);
+        LocalForward[i] = Local.X;
+        LocalSide[i] = Local.Y;
+        LocalUp[i] = Local.Z;
+        LocalRadiusSq[i] = Local.SizeSquared();
+        MaxRadiusSq = FMath::Max(MaxRadiusSq, LocalRadiusSq[i]);
+    }
+
+    // Padding repeats the last vertex so it never creates a crossing
+    for (int32 i = NumVertices; i < NumPadded; ++i)
+    {
+        LocalRadiusSq[i] = LocalRadiusSq[NumVertices - 1];
+    }
+
+    MaxRadius = FMath::Sqrt(MaxRadiusSq);
+}
+
+
+bool FBoomerangAimSolver::Solve(const FVector& Start, const FVector& Target, float Tolerance, FRotator& OutAim, float& OutPathAlpha) const
+{
+    if (!IsInitialized()) return false;
+
+    const FVector ToTarget = Target - Start;
+    const float DistSq = static_cast<float>(ToTarget.SizeSquared());
+
+    // Beyond the furthest point of the path
+    if (DistSq > FMath::Square(MaxRadius + Tolerance)) return false;
+
+    // A path point can only map onto the target where its distance from the start matches the target's.
+    // Mark which vertices are beyond that distance, four at a time.
+    const int32 NumPadded = LocalRadiusSq.Num();
+    TArray<uint8, TInlineAllocator<64>> Outside;
+    Outside.SetNumUninitialized(NumPadded);
+
+    const VectorRegister4Float TargetDistSq = VectorSetFloat1(DistSq);
+    for (int32 i = 0; i < NumPadded; i += 4)
+    {
+        const VectorRegister4Float RadiusSq = VectorLoad(&LocalRadiusSq[i]);
+        const int32 Mask = VectorMaskBits(VectorCompareGE(RadiusSq, TargetDistSq));
+        Outside[i] = Mask & 1;
+        Outside[i + 1] = (Mask >> 1) & 1;
+        Outside[i + 2] = (Mask >> 2) & 1;
+        Outside[i + 3] = (Mask >> 3) & 1;
+    }
+
+    const float TargetYaw = FMath::Atan2(static_cast<float>(ToTarget.Y), static_cast<float>(ToTarget.X));
+    const int32 NumSegments = NumVertices - 1;
+
+    // Earliest crossing first, so the target is hit as soon as possible
+    for (int32 Seg = 0; Seg < NumSegments; ++Seg)
+    {
+        if (Outside[Seg] == Outside[Seg + 1]) continue;
+
+        // Where along this segment the local point is exactly at the target's distance
+        const FVector3f P0(LocalForward[Seg], LocalSide[Seg], LocalUp[Seg]);
+        const FVector3f Dir(LocalForward[Seg + 1] - P0.X, LocalSide[Seg + 1] - P0.Y, LocalUp[Seg + 1] - P0.Z);
+
+        const float A = Dir.SizeSquared();
+        const float B = 2.f * FVector3f::DotProduct(P0, Dir);
+        const float C = P0.SizeSquared() - DistSq;
+        const float Disc = B * B - 4.f * A * C;
+        if (A <= UE_SMALL_NUMBER || Disc < 0.f) continue;
+
+        const float SqrtDisc = FMath::Sqrt(Disc);
+        float S = (-B - SqrtDisc) / (2.f * A);
+        if (S < 0.f || S > 1.f)
+        {
+            S = (-B + SqrtDisc) / (2.f * A);
+        }
+        S = FMath::Clamp(S, 0.f, 1.f);
+
+        const FVector3f Local = P0 + Dir * S;
+
+        // Pitch turns the (forward, up) pair so the point reaches the target's height: F sin(P) + U cos(P) = Z
+        const float ForwardUp = FMath::Sqrt(FMath::Square(Local.X) + FMath::Square(Local.Z));
+        if (ForwardUp <= UE_KINDA_SMALL_NUMBER) continue;
+
+        const float SinPitch = FMath::Clamp(static_cast<float>(ToTarget.Z) / ForwardUp, -1.f, 1.f);
+        const float Pitch = FMath::Asin(SinPitch) - FMath::Atan2(Local.Z, Local.X);
+
+        // Then yaw turns the horizontal (forward, side) pair onto the target
+        const float Horizontal = Local.X * FMath::Cos(Pitch) - Local.Z * FMath::Sin(Pitch);
+        const float Yaw = TargetYaw - FMath::Atan2(-Local.Y, Horizontal);
+
+        const FRotator Aim(FRotator::NormalizeAxis(FMath::RadiansToDegrees(Pitch)), FMath::RadiansToDegrees(Yaw), 0.f);
+        if (FMath::Abs(Aim.Pitch) > 89.f) continue;
+
+        // Check with the same frame the throw uses
+        const FVector Forward = Aim.Vector();
+        const FVector Right = FVector::CrossProduct(Forward, FVector::UpVector).GetSafeNormal();
+        const FVector Up = FVector::CrossProduct(Right, Forward);
+        const FVector PathPoint = Start + Forward * Local.X + Right * Local.Y + Up * Local.Z;
+
+        if (FVector::DistSquared(PathPoint, Target) <= FMath::Square(Tolerance))
+        {
+            OutAim = Aim.GetNormalized();
+            OutPathAlpha = (Seg + S) / NumSegments;
+            return true;
+        }
+    }
+
+    return false;
+}
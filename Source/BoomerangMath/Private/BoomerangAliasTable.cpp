@@ -0,0 +1,73 @@
+// BoomerangAliasTable.cpp
+
+#include "BoomerangAliasTable.h"
+
+
+void FBoomerangAliasTable::Build(TArrayView<const float> Weights)
+{
+    Reset();
+
+    double Total = 0.0;
+    for (float Weight : Weights)
+    {
+        Total += FMath::Max(Weight, 0.f);
+    }
+    if (Weights.Num() == 0 || Total <= 0.0) return;
+
+    const int32 Count = Weights.Num();
+    Threshold.SetNumUninitialized(Count);
+    Alias.SetNumUninitialized(Count);
+
+    // Scale so the average column is exactly 1
+    TArray<double> Scaled;
+    Scaled.SetNumUninitialized(Count);
+
+    TArray<int32> Small;
+    TArray<int32> Large;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        Scaled[i] = FMath::Max(Weights[i], 0.f) * Count / Total;
+        (Scaled[i] < 1.0 ? Small : Large).Add(i);
+    }
+
+    // Fill each under-full column with the remainder of an over-full one
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Less = Small.Pop(EAllowShrinking::No);
+        const int32 More = Large.Pop(EAllowShrinking::No);
+
+        Threshold[Less] = static_cast<float>(Scaled[Less]);
+        Alias[Less] = More;
+
+        Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+        (Scaled[More] < 1.0 ? Small : Large).Add(More);
+    }
+
+    // Whatever is left is full up to rounding error
+    for (int32 Index : Large)
+    {
+        Threshold[Index] = 1.f;
+        Alias[Index] = Index;
+    }
+    for (int32 Index : Small)
+    {
+        Threshold[Index] = 1.f;
+        Alias[Index] = Index;
+    }
+}
+
+
+int32 FBoomerangAliasTable::Sample(float U0, float U1) const
+{
+    check(!IsEmpty());
+
+    const int32 Column = FMath::Min(FMath::FloorToInt(U0 * Threshold.Num()), Threshold.Num() - 1);
+    return U1 < Threshold[Column] ? Column : Alias[Column];
+}
+
+
+void FBoomerangAliasTable::Reset()
+{
+    Threshold.Reset();
+    Alias.Reset();
+}
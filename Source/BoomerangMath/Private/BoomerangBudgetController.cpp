@@ -0,0 +1,41 @@
+// BoomerangBudgetController.cpp
+
+#include "BoomerangBudgetController.h"
+
+
+void FBoomerangBudgetController::AddFrameSample(float WorkMs)
+{
+    AverageMs = AverageMs > 0.f ? FMath::Lerp(AverageMs, WorkMs, 0.1f) : WorkMs;
+}
+
+
+int32 FBoomerangBudgetController::Update(float DeltaTime, float BudgetMs, float RestoreFraction, float AdjustInterval, int32 MaxLevel)
+{
+    TimeSinceAdjust += DeltaTime;
+    if (TimeSinceAdjust < AdjustInterval) return Level;
+
+    int32 NewLevel = Level;
+    if (AverageMs > BudgetMs)
+    {
+        NewLevel = Level + 1;
+    }
+    else if (AverageMs < BudgetMs * RestoreFraction)
+    {
+        NewLevel = Level - 1;
+    }
+
+    NewLevel = FMath::Clamp(NewLevel, 0, MaxLevel);
+    if (NewLevel != Level)
+    {
+        Level = NewLevel;
+        TimeSinceAdjust = 0.f;
+    }
+    return Level;
+}
+
+
+void FBoomerangBudgetController::SetLevel(int32 NewLevel)
+{
+    Level = NewLevel;
+    TimeSinceAdjust = 0.f;
+}
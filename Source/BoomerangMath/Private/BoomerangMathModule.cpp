@@ -0,0 +1,5 @@
+// BoomerangMathModule.cpp
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, BoomerangMath);
@@ -0,0 +1,182 @@
+// BoomerangTrajectory.cpp
+
+#include "BoomerangTrajectory.h"
+
+
+void BoomerangMath::BuildPath(const FVector& Start, const FRotator& Aim, float Distance, float CurveRadius,
+    int32 NumSegments, TArray<FVector>& OutPoints)
+{
+    const FVector Forward = Aim.Vector().GetSafeNormal();
+    const FVector Right = FVector::CrossProduct(Forward, FVector::UpVector).GetSafeNormal();
+
+    OutPoints.Reset(NumSegments + 1);
+    for (int32 i = 0; i <= NumSegments; ++i)
+    {
+        const float T = NumSegments > 0 ? static_cast<float>(i) / NumSegments : 0.f;
+        const FVector2f Local = EvaluateLocal(T, Distance, CurveRadius);
+
+        OutPoints.Add(Start + Forward * Local.X + Right * Local.Y);
+    }
+}
+
+
+void BoomerangMath::BuildPath(const FVector& Start, const FRotator& Aim, float Distance, float CurveRadius,
+    int32 NumSegments, TConstArrayView<FVector3f> ShapeTable, TArray<FVector>& OutPoints)
+{
+    if (ShapeTable.Num() < 2)
+    {
+        BuildPath(Start, Aim, Distance, CurveRadius, NumSegments, OutPoints);
+        return;
+    }
+
+    const FVector Forward = Aim.Vector().GetSafeNormal();
+    const FVector Right = FVector::CrossProduct(Forward, FVector::UpVector).GetSafeNormal();
+    const FVector Up = FVector::CrossProduct(Right, Forward);
+
+    OutPoints.Reset(NumSegments + 1);
+    for (int32 i = 0; i <= NumSegments; ++i)
+    {
+        const float T = NumSegments > 0 ? static_cast<float>(i) / NumSegments : 0.f;
+        const FVector3f Local = EvaluateTable(ShapeTable, T, Distance, CurveRadius);
+
+        OutPoints.Add(Start + Forward * Local.X + Right * Local.Y + Up * Local.Z);
+    }
+}
+
+
+void BoomerangMath::BakeShapeTable(TFunctionRef<FVector3f(float)> Evaluate, float CurveRatio, int32 NumEntries, TArray<FVector3f>& OutTable)
+{
+    NumEntries = FMath::Max(NumEntries, 2);
+
+    // Dense enough that linear steps between samples follow the curve closely
+    const int32 NumDense = NumEntries * 8;
+    const FVector3f Metric(1.f, CurveRatio, CurveRatio);
+
+    TArray<FVector3f> Dense;
+    TArray<float> Length;
+    Dense.SetNumUninitialized(NumDense + 1);
+    Length.SetNumUninitialized(NumDense + 1);
+
+    for (int32 i = 0; i <= NumDense; ++i)
+    {
+        Dense[i] = Evaluate(static_cast<float>(i) / NumDense);
+        Length[i] = i == 0 ? 0.f : Length[i - 1] + ((Dense[i] - Dense[i - 1]) * Metric).Size();
+    }
+
+    OutTable.Reset(NumEntries);
+
+    const float TotalLength = Length[NumDense];
+    if (TotalLength <= UE_KINDA_SMALL_NUMBER)
+    {
+        for (int32 i = 0; i < NumEntries; ++i)
+        {
+            OutTable.Add(Dense[i * NumDense / (NumEntries - 1)]);
+        }
+        return;
+    }
+
+    // Both sequences increase, so one walk over the dense samples finds every entry
+    int32 Seg = 0;
+    for (int32 i = 0; i < NumEntries; ++i)
+    {
+        const float Target = TotalLength * i / (NumEntries - 1);
+        while (Seg < NumDense - 1 && Length[Seg + 1] < Target)
+        {
+            ++Seg;
+        }
+
+        const float SegLength = Length[Seg + 1] - Length[Seg];
+        const float Alpha = SegLength > 0.f ? FMath::Clamp((Target - Length[Seg]) / SegLength, 0.f, 1.f) : 0.f;
+        OutTable.Add(FMath::Lerp(Dense[Seg], Dense[Seg + 1], Alpha));
+    }
+}
+
+
+float BoomerangMath::GetMaxRadius(float Distance, float CurveRadius, int32 NumSegments, TConstArrayView<FVector3f> ShapeTable)
+{
+    if (ShapeTable.Num() < 2) return GetMaxRadius(Distance, CurveRadius, NumSegments);
+
+    NumSegments = FMath::Max(NumSegments, 1);
+
+    float MaxRadiusSq = 0.f;
+    for (int32 i = 0; i <= NumSegments; ++i)
+    {
+        MaxRadiusSq = FMath::Max(MaxRadiusSq, EvaluateTable(ShapeTable, static_cast<float>(i) / NumSegments, Distance, CurveRadius).SizeSquared());
+    }
+    return FMath::Sqrt(MaxRadiusSq);
+}
+
+
+float BoomerangMath::GetMaxRadius(float Distance, float CurveRadius, int32 NumSegments)
+{
+    NumSegments = FMath::Max(NumSegments, 1);
+
+    float MaxRadiusSq = 0.f;
+    for (int32 i = 0; i <= NumSegments; ++i)
+    {
+        MaxRadiusSq = FMath::Max(MaxRadiusSq, EvaluateLocal(static_cast<float>(i) / NumSegments, Distance, CurveRadius).SizeSquared());
+    }
+    return FMath::Sqrt(MaxRadiusSq);
+}
+
+
+FVector BoomerangMath::SamplePath(TArrayView<const FVector> Points, float Alpha)
+{
+    if (Points.Num() == 0) return FVector::ZeroVector;
+    if (Points.Num() == 1) return Points[0];
+
+    const int32 NumSegments = Points.Num() - 1;
+    const float SegF = FMath::Clamp(Alpha, 0.f, 1.f) * NumSegments;   // e.g. 3.25 is 25% through the 4th segment
+    const int32 SegIndex = FMath::Clamp(FMath::FloorToInt(SegF), 0, NumSegments - 1);
+    const float LocalT = SegF - SegIndex;
+
+    return FMath::Lerp(Points[SegIndex], Points[SegIndex + 1], LocalT);
+}
+
+
+bool BoomerangMath::SweepSphereSphere(const FVector& Start, const FVector& End, float Radius,
+    const FVector& Center, float CenterRadius, float& OutTime)
+{
+    // Solve |Start + Dir * t - Center| = Radius + CenterRadius for the smallest t in [0, 1]
+    const FVector Dir = End - Start;
+    const FVector ToStart = Start - Center;
+    const double RadiusSum = static_cast<double>(Radius) + CenterRadius;
+
+    const double C = ToStart.SizeSquared() - RadiusSum * RadiusSum;
+    if (C <= 0.0)
+    {
+        OutTime = 0.f;
+        return true;
+    }
+
+    const double A = Dir.SizeSquared();
+    const double B = FVector::DotProduct(ToStart, Dir);
+    if (A <= UE_DOUBLE_SMALL_NUMBER || B >= 0.0) return false;   // not moving, or moving away
+
+    const double Disc = B * B - A * C;
+    if (Disc < 0.0) return false;
+
+    const double T = (-B - FMath::Sqrt(Disc)) / A;
+    if (T > 1.0) return false;
+
+    OutTime = static_cast<float>(T);
+    return true;
+}
+
+
+bool BoomerangMath::SweepPathSphere(TArrayView<const FVector> Points, float Radius,
+    const FVector& Center, float CenterRadius, float& OutAlpha)
+{
+    const int32 NumSegments = Points.Num() - 1;
+    for (int32 Seg = 0; Seg < NumSegments; ++Seg)
+    {
+        float Time;
+        if (SweepSphereSphere(Points[Seg], Points[Seg + 1], Radius, Center, CenterRadius, Time))
+        {
+            OutAlpha = (Seg + Time) / NumSegments;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,30 @@
+// BoomerangAimSolver.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Finds the aim whose boomerang path passes through a point.
+// The path shape in the throw's local (forward, side, up) frame doesn't depend on aim,
+// so it is tabulated once and each query only scans it for the target's range.
+class BOOMERANGMATH_API FBoomerangAimSolver
+{
+public:
+    // Same parameters as FBoomerangThrowDescriptor, an empty table is the built-in loop
+    void Initialize(float InDistance, float InCurveRadius, int32 InNumSegments, TConstArrayView<FVector3f> ShapeTable = {});
+
+    // Returns the earliest aim (pitch clamped to +-89) whose path passes within Tolerance of Target
+    bool Solve(const FVector& Start, const FVector& Target, float Tolerance, FRotator& OutAim, float& OutPathAlpha) const;
+
+    bool IsInitialized() const { return NumVertices >= 2; }
+
+private:
+    // Path vertices in the local frame, structure of arrays padded to a multiple of 4
+    TArray<float> LocalForward;
+    TArray<float> LocalSide;
+    TArray<float> LocalUp;
+    TArray<float> LocalRadiusSq;
+
+    int32 NumVertices = 0;
+    float MaxRadius = 0.f;
+};
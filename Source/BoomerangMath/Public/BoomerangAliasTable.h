@@ -0,0 +1,26 @@
+// BoomerangAliasTable.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Weighted random choice in O(1) per sample (Vose's alias method).
+// Building is O(n), so build once and sample many times.
+class BOOMERANGMATH_API FBoomerangAliasTable
+{
+public:
+    // Weights don't need to be normalized, entries with zero weight are never picked
+    void Build(TArrayView<const float> Weights);
+
+    // U0 and U1 are independent uniform values in [0, 1)
+    int32 Sample(float U0, float U1) const;
+
+    int32 Num() const { return Threshold.Num(); }
+    bool IsEmpty() const { return Threshold.Num() == 0; }
+    void Reset();
+
+private:
+    // Chance of keeping the picked column, otherwise its alias is used
+    TArray<float> Threshold;
+    TArray<int32> Alias;
+};
@@ -0,0 +1,28 @@
+// BoomerangBudgetController.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Steps a quality level up while smoothed per-frame work is over budget and back down with headroom.
+// Fed game-thread work only, never wall frame time, so vsync and frame-rate limiter waits don't count.
+class BOOMERANGMATH_API FBoomerangBudgetController
+{
+public:
+    // Work done this frame, in milliseconds
+    void AddFrameSample(float WorkMs);
+
+    // Returns the level to use, changing it at most once per AdjustInterval seconds
+    int32 Update(float DeltaTime, float BudgetMs, float RestoreFraction, float AdjustInterval, int32 MaxLevel);
+
+    // Forces a level, e.g. when the governor is disabled
+    void SetLevel(int32 NewLevel);
+
+    int32 GetLevel() const { return Level; }
+    float GetAverageMs() const { return AverageMs; }
+
+private:
+    int32 Level = 0;
+    float AverageMs = 0.f;
+    float TimeSinceAdjust = 0.f;
+};
@@ -0,0 +1,60 @@
+// BoomerangTrajectory.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+// Boomerang flight math, free of UObjects so it can run without a world
+namespace BoomerangMath
+{
+    // Point on the path at T (0 to 1) in the throw's local frame: X forward, Y to the right
+    FORCEINLINE FVector2f EvaluateLocal(float T, float Distance, float CurveRadius)
+    {
+        return FVector2f(
+            FMath::Sin(T * PI) * Distance,          // forward motion (0 > 1 > 0)
+            FMath::Sin(T * 2.f * PI) * CurveRadius); // sideways swing (0 > 1 > 0 > -1 > 0)
+    }
+
+    // Entries in a baked trajectory shape table
+    constexpr int32 ShapeTableSize = 256;
+
+    // Point on a baked shape table at T (0 to 1), in the same frame as EvaluateLocal plus Z up.
+    // Table X is scaled by Distance, Y and Z by CurveRadius.
+    FORCEINLINE FVector3f EvaluateTable(TConstArrayView<FVector3f> Table, float T, float Distance, float CurveRadius)
+    {
+        const float Index = FMath::Clamp(T, 0.f, 1.f) * (Table.Num() - 1);
+        const int32 I0 = FMath::Min(FMath::FloorToInt32(Index), Table.Num() - 2);
+        const FVector3f P = FMath::Lerp(Table[I0], Table[I0 + 1], Index - I0);
+        return FVector3f(P.X * Distance, P.Y * CurveRadius, P.Z * CurveRadius);
+    }
+
+    // Resamples a shape (T 0 to 1, table units) into NumEntries points evenly spaced by arc length,
+    // so a path built from the table flies at constant speed. Length is measured with Y and Z scaled by CurveRatio (CurveRadius / Distance).
+    BOOMERANGMATH_API void BakeShapeTable(TFunctionRef<FVector3f(float)> Evaluate, float CurveRatio, int32 NumEntries, TArray<FVector3f>& OutTable);
+
+    // Furthest any point of the sampled path gets from the throw origin, for any aim
+    BOOMERANGMATH_API float GetMaxRadius(float Distance, float CurveRadius, int32 NumSegments);
+    BOOMERANGMATH_API float GetMaxRadius(float Distance, float CurveRadius, int32 NumSegments, TConstArrayView<FVector3f> ShapeTable);
+
+    // Sample the path as NumSegments straight segments
+    BOOMERANGMATH_API void BuildPath(const FVector& Start, const FRotator& Aim, float Distance, float CurveRadius,
+        int32 NumSegments, TArray<FVector>& OutPoints);
+
+    // Same, following a baked shape table instead of the built-in loop. An empty table is the built-in loop.
+    BOOMERANGMATH_API void BuildPath(const FVector& Start, const FRotator& Aim, float Distance, float CurveRadius,
+        int32 NumSegments, TConstArrayView<FVector3f> ShapeTable, TArray<FVector>& OutPoints);
+
+    // Position at Alpha (0 to 1) along a sampled path, moving at a constant rate per segment
+    BOOMERANGMATH_API FVector SamplePath(TArrayView<const FVector> Points, float Alpha);
+
+    // Sphere moving from Start to End against a static sphere.
+    // OutTime is the fraction of the move at first contact, 0 if already touching.
+    BOOMERANGMATH_API bool SweepSphereSphere(const FVector& Start, const FVector& End, float Radius,
+        const FVector& Center, float CenterRadius, float& OutTime);
+
+    // Sweeps every segment of a path against a static sphere.
+    // OutAlpha is the path progress (0 to 1) at first contact.
+    BOOMERANGMATH_API bool SweepPathSphere(TArrayView<const FVector> Points, float Radius,
+        const FVector& Center, float CenterRadius, float& OutAlpha);
+}
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Command line benchmark for BoomerangMath, runs without the editor or a world:
+// BoomerangBench [-iterations=N] [-csv=Path]
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class BoomerangBenchTarget : TargetRules
+{
+	public BoomerangBenchTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "BoomerangBench";
+
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bIsBuildingConsoleApplication = true;
+	}
+}
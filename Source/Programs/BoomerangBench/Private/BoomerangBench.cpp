@@ -0,0 +1,277 @@
+// BoomerangBench.cpp
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "BoomerangTrajectory.h"
+#include "BoomerangAimSolver.h"
+#include "BoomerangAliasTable.h"
+#include "BoomerangBudgetController.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogBoomerangBench, Log, All);
+
+IMPLEMENT_APPLICATION(BoomerangBench, "BoomerangBench");
+
+namespace BoomerangBench
+{
+    // Same shape as the default boomerang blueprint
+    constexpr float Distance = 1500.f;
+    constexpr float CurveRadius = 400.f;
+    constexpr int32 NumSegments = 32;
+    constexpr float SweepRadius = 12.f;
+    constexpr float TargetRadius = 50.f;
+
+    struct FResult
+    {
+        FString Name;
+        double NsPerOp;
+    };
+
+    static int32 NumFailures = 0;
+
+    void Check(bool bCondition, const TCHAR* What)
+    {
+        if (!bCondition)
+        {
+            UE_LOG(LogBoomerangBench, Error, TEXT("Check failed: %s"), What);
+            NumFailures++;
+        }
+    }
+
+    // Loop that climbs on the way out and drops back to the hand, in shape table units
+    FVector3f ClimbingLoop(float T)
+    {
+        return FVector3f(FMath::Sin(T * PI), FMath::Sin(T * 2.f * PI), FMath::Square(FMath::Sin(T * PI)));
+    }
+
+    // Times Iterations calls of Body, which returns something to keep the optimizer honest
+    template<typename BodyType>
+    FResult Measure(const TCHAR* Name, int32 Iterations, BodyType&& Body)
+    {
+        double Sink = 0.0;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 i = 0; i < Iterations; ++i)
+        {
+            Sink += Body(i);
+        }
+        const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        FResult Result{ Name, Seconds * 1e9 / Iterations };
+        UE_LOG(LogBoomerangBench, Display, TEXT("%-24s %10.1f ns/op  (%d iterations, sink %.1f)"), Name, Result.NsPerOp, Iterations, Sink);
+        return Result;
+    }
+
+    // Ten seconds at 60 fps with WorkMs of game-thread work per frame, against the default 10 ms budget
+    int32 RunBudgetController(float WorkMs)
+    {
+        FBoomerangBudgetController Controller;
+        for (int32 Frame = 0; Frame < 600; ++Frame)
+        {
+            Controller.AddFrameSample(WorkMs);
+            Controller.Update(1.f / 60.f, 10.f, 0.75f, 1.f, 3);
+        }
+        return Controller.GetLevel();
+    }
+
+    // Correctness checks, run before timing so a broken kernel doesn't report a fast time
+    void RunChecks()
+    {
+        const FVector Start(100.f, -50.f, 80.f);
+        const FRotator Aim(10.f, 35.f, 0.f);
+
+        TArray<FVector> Path;
+        BoomerangMath::BuildPath(Start, Aim, Distance, CurveRadius, NumSegments, Path);
+        Check(Path.Num() == NumSegments + 1, TEXT("BuildPath returns NumSegments + 1 points"));
+        Check(Path[0].Equals(Start, 0.01), TEXT("path starts at the throw origin"));
+        Check(Path.Last().Equals(Start, 0.01), TEXT("path returns to the throw origin"));
+        Check(FMath::IsNearlyEqual(FVector::Dist(Path[NumSegments / 2], Start), Distance, 1.0), TEXT("path halfway point is Distance away"));
+
+        Check(BoomerangMath::SamplePath(Path, 0.f).Equals(Path[0]), TEXT("SamplePath at 0 is the first point"));
+        Check(BoomerangMath::SamplePath(Path, 1.f).Equals(Path.Last()), TEXT("SamplePath at 1 is the last point"));
+        Check(BoomerangMath::SamplePath(Path, 0.5f / NumSegments).Equals((Path[0] + Path[1]) * 0.5, 0.01), TEXT("SamplePath lerps within a segment"));
+
+        float Time = -1.f;
+        Check(BoomerangMath::SweepSphereSphere(FVector(-100, 0, 0), FVector(100, 0, 0), 10.f, FVector::ZeroVector, 40.f, Time)
+            && FMath::IsNearlyEqual(Time, 0.25f, 1e-4f), TEXT("head-on sweep hits a quarter of the way"));
+        Check(!BoomerangMath::SweepSphereSphere(FVector(-100, 60, 0), FVector(100, 60, 0), 10.f, FVector::ZeroVector, 40.f, Time), TEXT("sweep passing beside misses"));
+        Check(!BoomerangMath::SweepSphereSphere(FVector(100, 0, 0), FVector(200, 0, 0), 10.f, FVector::ZeroVector, 40.f, Time), TEXT("sweep moving away misses"));
+
+        // Baked shapes must come back to the hand and fly at constant speed
+        TArray<FVector3f> ShapeTable;
+        BoomerangMath::BakeShapeTable(ClimbingLoop, CurveRadius / Distance, BoomerangMath::ShapeTableSize, ShapeTable);
+        Check(ShapeTable.Num() == BoomerangMath::ShapeTableSize, TEXT("BakeShapeTable returns NumEntries points"));
+
+        BoomerangMath::BuildPath(Start, Aim, Distance, CurveRadius, NumSegments, ShapeTable, Path);
+        Check(Path[0].Equals(Start, 0.01) && Path.Last().Equals(Start, 0.01), TEXT("table path starts and ends at the throw origin"));
+
+        float MinSegment = UE_BIG_NUMBER;
+        float MaxSegment = 0.f;
+        for (int32 i = 1; i < Path.Num(); ++i)
+        {
+            MinSegment = FMath::Min(MinSegment, static_cast<float>(FVector::Dist(Path[i - 1], Path[i])));
+            MaxSegment = FMath::Max(MaxSegment, static_cast<float>(FVector::Dist(Path[i - 1], Path[i])));
+        }
+        Check(MinSegment > MaxSegment * 0.9f, TEXT("table path segments are evenly spaced by arc length"));
+
+        // Every solved aim must produce a path that actually reaches the target, for the built-in loop and a baked shape
+        for (const TConstArrayView<FVector3f> Table : { TConstArrayView<FVector3f>(), TConstArrayView<FVector3f>(ShapeTable) })
+        {
+            FBoomerangAimSolver Solver;
+            Solver.Initialize(Distance, CurveRadius, NumSegments, Table);
+
+            FRandomStream Stream(1234);
+            int32 NumSolved = 0;
+            for (int32 i = 0; i < 256; ++i)
+            {
+                const FVector Target = Start + Stream.GetUnitVector() * Stream.FRandRange(100.f, Distance);
+
+                FRotator SolvedAim;
+                float PathAlpha;
+                if (!Solver.Solve(Start, Target, SweepRadius, SolvedAim, PathAlpha)) continue;
+
+                NumSolved++;
+                BoomerangMath::BuildPath(Start, SolvedAim, Distance, CurveRadius, NumSegments, Table, Path);
+
+                float HitAlpha;
+                Check(BoomerangMath::SweepPathSphere(Path, SweepRadius, Target, 1.f, HitAlpha), TEXT("solved aim reaches the target"));
+            }
+            Check(NumSolved > 0, TEXT("aim solver finds some aims in range"));
+        }
+
+        // A vsynced idle frame is 16.6 ms of wall time but only a few of work, it must not cost quality
+        Check(RunBudgetController(3.f) == 0, TEXT("budget controller stays at level 0 on an idle vsynced frame"));
+        Check(RunBudgetController(16.6f) == 3, TEXT("budget controller steps down quality when over budget"));
+
+        // Alias table should pick in proportion to the weights and never pick a zero weight
+        const float Weights[] = { 1.f, 0.f, 3.f, 4.f };
+        FBoomerangAliasTable Table;
+        Table.Build(Weights);
+
+        int32 Counts[4] = {};
+        for (int32 i = 0; i < 80000; ++i)
+        {
+            Counts[Table.Sample(Stream.GetFraction(), Stream.GetFraction())]++;
+        }
+        Check(Counts[1] == 0, TEXT("alias table never picks a zero weight"));
+        Check(FMath::IsNearlyEqual(Counts[3] / 80000.f, 0.5f, 0.02f), TEXT("alias table picks in proportion to weight"));
+    }
+
+    TArray<FResult> RunBenchmarks(int32 Iterations)
+    {
+        TArray<FResult> Results;
+
+        const FVector Start(0.f, 0.f, 100.f);
+        TArray<FVector> Path;
+        BoomerangMath::BuildPath(Start, FRotator(5.f, 20.f, 0.f), Distance, CurveRadius, NumSegments, Path);
+
+        // Inputs are precomputed so only the kernel is timed
+        FRandomStream Stream(42);
+        TArray<FRotator> Aims;
+        TArray<FVector> Targets;
+        for (int32 i = 0; i < 1024; ++i)
+        {
+            Aims.Add(FRotator(Stream.FRandRange(-30.f, 30.f), Stream.FRandRange(-180.f, 180.f), 0.f));
+            Targets.Add(Start + Stream.GetUnitVector() * Stream.FRandRange(100.f, Distance));
+        }
+
+        // Reset keeps the allocation, as the preview does frame to frame
+        TArray<FVector> Scratch;
+        Results.Add(Measure(TEXT("BuildPath"), Iterations, [&](int32 i)
+        {
+            BoomerangMath::BuildPath(Start, Aims[i & 1023], Distance, CurveRadius, NumSegments, Scratch);
+            return Scratch[1].X;
+        }));
+
+        // A baked shape should cost the same as the built-in loop
+        TArray<FVector3f> ShapeTable;
+        BoomerangMath::BakeShapeTable(ClimbingLoop, CurveRadius / Distance, BoomerangMath::ShapeTableSize, ShapeTable);
+        Results.Add(Measure(TEXT("BuildPath (table)"), Iterations, [&](int32 i)
+        {
+            BoomerangMath::BuildPath(Start, Aims[i & 1023], Distance, CurveRadius, NumSegments, ShapeTable, Scratch);
+            return Scratch[1].X;
+        }));
+
+        Results.Add(Measure(TEXT("SamplePath"), Iterations, [&](int32 i)
+        {
+            return BoomerangMath::SamplePath(Path, (i & 1023) / 1023.f).X;
+        }));
+
+        Results.Add(Measure(TEXT("SweepPathSphere"), Iterations, [&](int32 i)
+        {
+            float Alpha = 0.f;
+            BoomerangMath::SweepPathSphere(Path, SweepRadius, Targets[i & 1023], TargetRadius, Alpha);
+            return Alpha;
+        }));
+
+        FBoomerangAimSolver Solver;
+        Solver.Initialize(Distance, CurveRadius, NumSegments);
+        Results.Add(Measure(TEXT("AimSolver.Solve"), Iterations, [&](int32 i)
+        {
+            FRotator Aim;
+            float Alpha = 0.f;
+            Solver.Solve(Start, Targets[i & 1023], SweepRadius, Aim, Alpha);
+            return Alpha;
+        }));
+
+        TArray<float> Weights;
+        for (int32 i = 0; i < 4096; ++i)
+        {
+            Weights.Add(Stream.GetFraction());
+        }
+        FBoomerangAliasTable Table;
+        Table.Build(Weights);
+        Results.Add(Measure(TEXT("AliasTable.Sample"), Iterations, [&](int32 i)
+        {
+            return Table.Sample((i & 1023) / 1024.f, ((i * 7) & 1023) / 1024.f);
+        }));
+
+        return Results;
+    }
+}
+
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    FTaskTagScope Scope(ETaskTag::EGameThread);
+    ON_SCOPE_EXIT
+    {
+        FEngineLoop::AppPreExit();
+        FModuleManager::Get().UnloadModulesAtShutdown();
+        FEngineLoop::AppExit();
+    };
+
+    if (int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+    {
+        return Ret;
+    }
+
+    using namespace BoomerangBench;
+
+    int32 Iterations = 200000;
+    FParse::Value(FCommandLine::Get(), TEXT("-iterations="), Iterations);
+    Iterations = FMath::Max(Iterations, 1);
+
+    RunChecks();
+    if (NumFailures > 0)
+    {
+        UE_LOG(LogBoomerangBench, Error, TEXT("%d check(s) failed, skipping benchmarks"), NumFailures);
+        return 1;
+    }
+
+    const TArray<FResult> Results = RunBenchmarks(Iterations);
+
+    // One row per kernel so runs can be diffed or graphed over time
+    FString CsvPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("-csv="), CsvPath))
+    {
+        FString Csv = TEXT("Kernel,NsPerOp\n");
+        for (const FResult& Result : Results)
+        {
+            Csv += FString::Printf(TEXT("%s,%.2f\n"), *Result.Name, Result.NsPerOp);
+        }
+        FFileHelper::SaveStringToFile(Csv, *CsvPath);
+        UE_LOG(LogBoomerangBench, Display, TEXT("Wrote %s"), *CsvPath);
+    }
+
+    return 0;
+}
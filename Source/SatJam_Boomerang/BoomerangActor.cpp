@@ -1,10 +1,75 @@
 // BoomerangActor.cpp
 
 #include "BoomerangActor.h"
+#include "BoomerangStats.h"
+#include "BoomerangMemory.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangTelemetry.h"
+#include "BoomerangHeatmapSubsystem.h"
+#include "BoomerangDistanceFieldSubsystem.h"
+#include "BoomerangSettings.h"
+#include "BoomerangSettleSubsystem.h"
+#include "HitFeedbackSubsystem.h"
 #include "GameManager.h"
+#include "SpawnDirectorSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "BoomerangTarget.h"
+#include "BoomerangTrajectory.h"
+#include "ThrowLatencyTracker.h"
 #include "Kismet/GameplayStatics.h"
+#include "EngineUtils.h"
+
+namespace BoomerangTumble
+{
+    // One keyframe of the precomputed settle, relative to the impact point
+    struct FKey
+    {
+        float Slide;    // along the surface, in the flight direction
+        float Bounce;   // along the impact normal
+        float Tumble;   // degrees of roll
+    };
+
+    constexpr float SampleRate = 30.f;
+    constexpr float Duration = 1.5f;
+
+    // Bouncing, sliding and tumbling to rest, simulated once at startup instead of per boomerang
+    static const TArray<FKey>& GetKeys()
+    {
+        static const TArray<FKey> Keys = []()
+        {
+            TArray<FKey> Result;
+            const int32 NumKeys = FMath::CeilToInt(Duration * SampleRate) + 1;
+            const float Dt = 1.f / SampleRate;
+
+            float Slide = 0.f, SlideSpeed = 300.f;
+            float Bounce = 0.f, BounceSpeed = 250.f;
+            float Tumble = 0.f, TumbleSpeed = 540.f;
+
+            for (int32 i = 0; i < NumKeys; ++i)
+            {
+                Result.Add({ Slide, Bounce, Tumble });
+
+                Slide += SlideSpeed * Dt;
+                SlideSpeed *= 0.85f;    // friction
+
+                BounceSpeed -= 980.f * Dt;
+                Bounce += BounceSpeed * Dt;
+                if (Bounce < 0.f)
+                {
+                    Bounce = 0.f;
+                    BounceSpeed = -BounceSpeed * 0.35f;     // restitution
+                }
+
+                Tumble += TumbleSpeed * Dt;
+                TumbleSpeed *= 0.8f;
+            }
+
+            return Result;
+        }();
+        return Keys;
+    }
+}
+
 
 ABoomerangActor::ABoomerangActor()
 {
@@ -28,12 +93,25 @@ ABoomerangActor::ABoomerangActor()
     // Bind overlap for targets and hit for blocking world collisions (when physics enabled)
     BoomerangMesh->OnComponentBeginOverlap.AddDynamic(this, &ABoomerangActor::OnBeginOverlap);
     BoomerangMesh->OnComponentHit.AddDynamic(this, &ABoomerangActor::OnHit);
+    BoomerangMesh->OnComponentSleep.AddDynamic(this, &ABoomerangActor::OnSettleSleep);
 }
 
 
 void ABoomerangActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    INC_DWORD_STAT(STAT_LiveBoomerangs);
+}
+
+
+void ABoomerangActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    DEC_DWORD_STAT(STAT_LiveBoomerangs);
+
+    ReleaseSimulationSlot();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 
@@ -48,6 +126,8 @@ void ABoomerangActor::InitializeBoomerang(const FVector& Direction, APlayerPawnB
 // Initialize using precomputed spline path
 void ABoomerangActor::InitializeWithPath(const TArray<FVector>& InPath, APlayerPawnBoomerang* Player)
 {
+    LLM_SCOPE_BYTAG(Boomerang);
+
     PathPoints = InPath;
     PlayerRef = Player;
     bFollowingPath = PathPoints.Num() >= 2;
@@ -55,30 +135,172 @@ void ABoomerangActor::InitializeWithPath(const TArray<FVector>& InPath, APlayerP
 
     // Disable physics during scripted path
     BoomerangMesh->SetSimulatePhysics(false);
+
+    bScheduledHits = bFollowingPath && GetDefault<UBoomerangSettings>()->bScheduleFlightHits;
+    if (bScheduledHits)
+    {
+        // Nothing is swept along the way, overlap events would only cost time
+        BoomerangMesh->SetGenerateOverlapEvents(false);
+
+        BOOMERANG_SCOPE_FRAME_COST(Sweep);
+        ScheduleWallHit();
+        ScheduleTargetHits(0.f);
+    }
+}
+
+
+void ABoomerangActor::ScheduleWallHit()
+{
+    const UBoomerangDistanceFieldSubsystem* StaticCollision = GetWorld()->GetSubsystem<UBoomerangDistanceFieldSubsystem>();
+    const int32 NumSegments = PathPoints.Num() - 1;
+
+    WallAlpha = 2.f;
+    if (!StaticCollision) return;
+
+    for (int32 i = 1; i < PathPoints.Num(); ++i)
+    {
+        if (StaticCollision->SweepStatic(PathPoints[i - 1], PathPoints[i], SweepRadius, WallHit))
+        {
+            WallAlpha = (i - 1 + WallHit.Time) / NumSegments;
+            break;
+        }
+    }
+}
+
+
+void ABoomerangActor::ScheduleTargetHits(float FromAlpha)
+{
+    ScheduledHits.Reset();
+
+    if (const USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+    {
+        ScheduledTargetSpawns = Director->GetNumTargetsSpawned();
+    }
+
+    // Only the segments still ahead, so a loop that crosses a new target's spot again still finds it
+    const int32 NumSegments = PathPoints.Num() - 1;
+    const int32 FirstSegment = FMath::Clamp(FMath::FloorToInt(FromAlpha * NumSegments), 0, NumSegments - 1);
+    const TArrayView<const FVector> Remaining = TArrayView<const FVector>(PathPoints).Slice(FirstSegment, PathPoints.Num() - FirstSegment);
+
+    // Targets don't move, so the first contact with the bounding sphere is the earliest the overlap could happen
+    const FVector FromPosition = BoomerangMath::SamplePath(PathPoints, FromAlpha);
+    for (TActorIterator<ABoomerangTarget> It(GetWorld()); It; ++It)
+    {
+        const float HitRadius = It->GetHitRadius();
+
+        float RemainingAlpha;
+        if (!BoomerangMath::SweepPathSphere(Remaining, SweepRadius, It->GetActorLocation(), HitRadius, RemainingAlpha)) continue;
+
+        float HitAlpha = (FirstSegment + RemainingAlpha * (Remaining.Num() - 1)) / NumSegments;
+        if (HitAlpha < FromAlpha)
+        {
+            // Contact began earlier in the segment, still live if the flight hasn't left the sphere yet
+            if (FVector::DistSquared(FromPosition, It->GetActorLocation()) > FMath::Square(SweepRadius + HitRadius)) continue;
+            HitAlpha = FromAlpha;
+        }
+
+        if (HitAlpha <= WallAlpha)
+        {
+            ScheduledHits.Add({ *It, HitAlpha });
+        }
+    }
+
+    ScheduledHits.Sort([](const FScheduledHit& A, const FScheduledHit& B) { return A.Alpha < B.Alpha; });
+}
+
+
+// Initialize from a throw descriptor (used on both server and clients)
+void ABoomerangActor::InitializeFromDescriptor(const FBoomerangThrowDescriptor& Descriptor, APlayerPawnBoomerang* Player, bool bInCosmetic)
+{
+    TArray<FVector> Path;
+    Descriptor.BuildPath(Path);
+
+    TotalFlightTime = Descriptor.GetFlightTime();
+    bCosmetic = bInCosmetic;
+    InitializeWithPath(Path, Player);
 }
 
 
 void ABoomerangActor::Tick(float DeltaTime)
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_BoomerangTick);
+
     Super::Tick(DeltaTime);
 
+    FThrowLatencyTracker::NotifyBoomerangTick(this);
+
+    if (bPlayingBakedTumble)
+    {
+        TickBakedTumble(DeltaTime);
+        return;
+    }
+
     if (bHasHitGround) return;
 
     // Follow the precomputed path
     if (bFollowingPath && PathPoints.Num() >= 2)
     {
+        const float PrevAlpha = FMath::Clamp(PathTime / TotalFlightTime, 0.f, 1.f);
         PathTime += DeltaTime;
 		float Alpha = FMath::Clamp(PathTime / TotalFlightTime, 0.f, 1.f);   // normalied (0 to 1) progress along the full trajectory
 
-		int32 NumSegments = PathPoints.Num() - 1;   // total number of straight lines between points
-        float SegF = Alpha * NumSegments;   // the continuous fractional segment index (e.g., 3.25 means 25% through the 4th segment)
-		int32 SegIndex = FMath::Clamp(FMath::FloorToInt(SegF), 0, NumSegments - 1); // int of current segment
-		float LocalT = SegF - SegIndex; // decimal part, progress along current segment
+		FVector DesiredPos = BoomerangMath::SamplePath(PathPoints, Alpha);   // smoothly interpolate between the two surrounding points
+
+        FlightDirection = DesiredPos - GetActorLocation();
+
+        if (bScheduledHits)
+        {
+            // Targets spawned since the last schedule might sit on the rest of the path
+            const USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>();
+            if (Director && Director->GetNumTargetsSpawned() != ScheduledTargetSpawns)
+            {
+                BOOMERANG_SCOPE_FRAME_COST(Sweep);
+                ScheduleTargetHits(PrevAlpha);
+            }
+
+            // Confirm every hit whose sphere the flight has reached against the target's collision, none past the wall
+            const float ReachedAlpha = FMath::Min(Alpha, WallAlpha);
+            const FVector MoveStart = GetActorLocation();
+            const FVector MoveEnd = Alpha >= WallAlpha ? WallHit.Location : DesiredPos;
+            for (int32 i = 0; i < ScheduledHits.Num() && ScheduledHits[i].Alpha <= ReachedAlpha; )
+            {
+                ABoomerangTarget* Target = ScheduledHits[i].Target.Get();
+                if (Target && Target->IsTouchedBySweep(MoveStart, MoveEnd, SweepRadius))
+                {
+                    HitTarget(Target);
+                }
+                else if (Target && FVector::DistSquared(MoveEnd, Target->GetActorLocation()) <= FMath::Square(SweepRadius + Target->GetHitRadius()))
+                {
+                    // Inside the bounding sphere but not touching the mesh yet, try again next frame
+                    ++i;
+                    continue;
+                }
+                ScheduledHits.RemoveAt(i, EAllowShrinking::No);
+            }
+
+            if (Alpha >= WallAlpha)
+            {
+                SetActorLocation(WallHit.Location);
+                BeginSettling(WallHit);
+                return;
+            }
 
-		FVector DesiredPos = FMath::Lerp(PathPoints[SegIndex], PathPoints[SegIndex + 1], LocalT);   // smoothly interpolate between the two points
+            SetActorLocation(DesiredPos);
+            AddActorLocalRotation(FRotator(0.f, 720.f * DeltaTime, 0.f));
+
+            if (Alpha >= 1.f)
+            {
+                Destroy();
+            }
+            return;
+        }
 
         FHitResult Hit;
-        SetActorLocation(DesiredPos, true, &Hit); // sweep enabled
+        {
+            BOOMERANG_SCOPE_FRAME_COST(Sweep);
+            SetActorLocation(DesiredPos, true, &Hit); // sweep enabled
+        }
+        INC_DWORD_STAT(STAT_BoomerangSweeps);
 
         // Visual spin
         AddActorLocalRotation(FRotator(0.f, 720.f * DeltaTime, 0.f));
@@ -89,15 +311,12 @@ void ABoomerangActor::Tick(float DeltaTime)
             AActor* HitActor = Hit.GetActor();
             ECollisionChannel ObjType = HitComp ? HitComp->GetCollisionObjectType() : ECC_Visibility;
 
-            UE_LOG(LogTemp, Verbose, TEXT("Sweep hit actor=%s objType=%d"), HitActor ? *HitActor->GetName() : TEXT("None"), (int32)ObjType);
+            UE_LOG(LogBoomerang, Verbose, TEXT("Sweep hit actor=%s objType=%d"), HitActor ? *HitActor->GetName() : TEXT("None"), (int32)ObjType);
 
-            // If this is a world static (ground/wall) collision, stop and enable physics
+            // If this is a world static (ground/wall) collision, stop and settle
             if (ObjType == ECC_WorldStatic)
             {
-                bHasHitGround = true;
-                bFollowingPath = false;
-                BoomerangMesh->SetSimulatePhysics(true); // now physics reacts
-                SetLifeSpan(3.f);
+                BeginSettling(Hit);
                 return;
             }
         }
@@ -125,12 +344,12 @@ void ABoomerangActor::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
 
     if (OtherActor && OtherActor->IsA(ABoomerangTarget::StaticClass()))
     {
-        UE_LOG(LogTemp, Log, TEXT("Boomerang hit target, passing through"));
+        UE_LOG(LogBoomerang, Log, TEXT("Boomerang hit target, passing through"));
 
         // Disable collision between the boomerang and the target instantly
         if (OtherComp)
         {
-            UE_LOG(LogTemp, Log, TEXT("Other comp"));
+            UE_LOG(LogBoomerang, Log, TEXT("Other comp"));
             HitComp->IgnoreActorWhenMoving(OtherActor, true);
             OtherComp->IgnoreActorWhenMoving(this, true);
         }
@@ -141,10 +360,128 @@ void ABoomerangActor::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
     // Handle ground or walls (stop)
     if (OtherActor && OtherComp && OtherComp->GetCollisionObjectType() == ECC_WorldStatic)
     {
-        UE_LOG(LogTemp, Log, TEXT("Boomerang hit ground"));
-        bHasHitGround = true;
+        UE_LOG(LogBoomerang, Log, TEXT("Boomerang hit ground"));
+        BeginSettling(Hit);
+    }
+}
+
+
+// Stop flying and settle, with physics if a slot is free, otherwise with the baked tumble
+void ABoomerangActor::BeginSettling(const FHitResult& Hit)
+{
+    if (bHasHitGround) return;
+
+    FBoomerangTelemetry::Record(EBoomerangEvent::GroundImpact, Hit.ImpactPoint, GetUniqueID());
+
+    // Client copies land too, only the server's flight counts
+    if (UBoomerangHeatmapSubsystem* Heatmap = bCosmetic ? nullptr : GetWorld()->GetSubsystem<UBoomerangHeatmapSubsystem>())
+    {
+        Heatmap->RecordGroundImpact(Hit.ImpactPoint);
+    }
+
+    if (UHitFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<UHitFeedbackSubsystem>())
+    {
+        Feedback->Play(EHitFeedback::GroundImpact, Hit.ImpactPoint);
+    }
+
+    bHasHitGround = true;
+    bFollowingPath = false;
+
+    // Grounded boomerangs still pop targets they tumble into
+    if (bScheduledHits)
+    {
+        BoomerangMesh->SetGenerateOverlapEvents(true);
+    }
+
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    SetLifeSpan(Settings->SettleLifeSpan);
+
+    UBoomerangSettleSubsystem* SettleSubsystem = GetWorld()->GetSubsystem<UBoomerangSettleSubsystem>();
+    if (SettleSubsystem && SettleSubsystem->TryBeginSimulating(this))
+    {
+        bHasSimulationSlot = true;
+
+        // Sleep early and damp hard so settling bodies leave the solver quickly
+        BoomerangMesh->BodyInstance.SleepFamily = ESleepFamily::Custom;
+        BoomerangMesh->BodyInstance.CustomSleepThresholdMultiplier = Settings->SettleSleepThresholdMultiplier;
+        BoomerangMesh->SetLinearDamping(Settings->SettleLinearDamping);
+        BoomerangMesh->SetAngularDamping(Settings->SettleAngularDamping);
+
+        // Chaos only reports sleep to bodies that ask for it
+        BoomerangMesh->BodyInstance.bGenerateWakeEvents = true;
+
+        BoomerangMesh->SetSimulatePhysics(true); // now physics reacts
+        GetWorldTimerManager().SetTimer(SettleTimeoutHandle, this, &ABoomerangActor::EndSimulatedSettle, Settings->SettleSleepTimeout, false);
+        SetActorTickEnabled(false);
+        return;
+    }
+
+    // No physics slot left, play the precomputed settle instead
+    bPlayingBakedTumble = true;
+    TumbleTime = 0.f;
+    TumbleOrigin = GetActorLocation();
+    TumbleNormal = Hit.ImpactNormal.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+    TumbleRotation = GetActorRotation();
+
+    // Slide along the surface in the direction the boomerang was travelling
+    TumbleSlideDir = FVector::VectorPlaneProject(FlightDirection, TumbleNormal).GetSafeNormal();
+
+    BoomerangMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
+
+void ABoomerangActor::TickBakedTumble(float DeltaTime)
+{
+    const TArray<BoomerangTumble::FKey>& Keys = BoomerangTumble::GetKeys();
+
+    TumbleTime += DeltaTime;
+    const float KeyF = FMath::Min(TumbleTime * BoomerangTumble::SampleRate, static_cast<float>(Keys.Num() - 1));
+    const int32 Index = FMath::Min(FMath::FloorToInt(KeyF), Keys.Num() - 2);
+    const float Alpha = KeyF - Index;
+
+    const float Slide = FMath::Lerp(Keys[Index].Slide, Keys[Index + 1].Slide, Alpha);
+    const float Bounce = FMath::Lerp(Keys[Index].Bounce, Keys[Index + 1].Bounce, Alpha);
+    const float Tumble = FMath::Lerp(Keys[Index].Tumble, Keys[Index + 1].Tumble, Alpha);
+
+    SetActorLocationAndRotation(
+        TumbleOrigin + TumbleSlideDir * Slide + TumbleNormal * Bounce,
+        TumbleRotation + FRotator(0.f, 0.f, Tumble));
+
+    // Done, nothing left to animate until the lifespan ends
+    if (TumbleTime >= BoomerangTumble::Duration)
+    {
+        bPlayingBakedTumble = false;
         SetActorTickEnabled(false);
-        SetLifeSpan(3.0f);
+    }
+}
+
+
+void ABoomerangActor::OnSettleSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+    // Resting bodies don't need the solver anymore
+    EndSimulatedSettle();
+}
+
+
+void ABoomerangActor::EndSimulatedSettle()
+{
+    if (!bHasSimulationSlot) return;
+
+    // On timeout the body may still be rocking, freezing it in place is the price of keeping the budget
+    GetWorldTimerManager().ClearTimer(SettleTimeoutHandle);
+    BoomerangMesh->SetSimulatePhysics(false);
+    ReleaseSimulationSlot();
+}
+
+
+void ABoomerangActor::ReleaseSimulationSlot()
+{
+    if (!bHasSimulationSlot) return;
+
+    bHasSimulationSlot = false;
+    if (UBoomerangSettleSubsystem* SettleSubsystem = GetWorld()->GetSubsystem<UBoomerangSettleSubsystem>())
+    {
+        SettleSubsystem->EndSimulating(this);
     }
 }
 
@@ -152,25 +489,44 @@ void ABoomerangActor::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
 void ABoomerangActor::OnBeginOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_BoomerangOverlap);
+    BOOMERANG_SCOPE_FRAME_COST(Overlap);
+
     if (!OtherActor || OtherActor == this) return;
 
     // If overlapped a boomerang target, destroy the target and keep flying.
     if (ABoomerangTarget* Target = Cast<ABoomerangTarget>(OtherActor))
     {
-        UE_LOG(LogTemp, Log, TEXT("Boomerang overlapped target: %s"), *Target->GetName());
+        UE_LOG(LogBoomerang, Log, TEXT("Boomerang overlapped target: %s"), *Target->GetName());
 
-        // let the target destroy itself
-        Target->Destroy();
+        HitTarget(Target);
+    }
+}
 
-        // Award points through GameManager
-        AGameManager* GameManager = Cast<AGameManager>(
-            UGameplayStatics::GetActorOfClass(GetWorld(), AGameManager::StaticClass())
-        );
 
-        if (GameManager)
-        {
-            GameManager->AddScore(100);
-        }
+void ABoomerangActor::HitTarget(ABoomerangTarget* Target)
+{
+    // let the target destroy itself
+    Target->HandleHit();
+
+    // Client copies only remove the local target, the server awards points
+    if (bCosmetic) return;
+
+    FBoomerangTelemetry::Record(EBoomerangEvent::Hit, Target->GetActorLocation(), Target->GetUniqueID());
+
+    if (UBoomerangHeatmapSubsystem* Heatmap = GetWorld()->GetSubsystem<UBoomerangHeatmapSubsystem>())
+    {
+        Heatmap->RecordTarget(Target->GetActorLocation(), true);
+    }
+
+    // Award points through GameManager
+    AGameManager* GameManager = Cast<AGameManager>(
+        UGameplayStatics::GetActorOfClass(GetWorld(), AGameManager::StaticClass())
+    );
+
+    if (GameManager)
+    {
+        GameManager->AddScore(100);
     }
 }
 
@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "PlayerPawnBoomerang.h"
+#include "BoomerangThrowDescriptor.h"
 #include "BoomerangActor.generated.h"
 
+class ABoomerangTarget;
+class UBoomerangTrajectoryShape;
+
 UCLASS()
 class SATJAM_BOOMERANG_API ABoomerangActor : public AActor
 {
@@ -17,6 +21,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
     virtual void Destroyed() override;
 
@@ -47,6 +52,65 @@ private:
     FVector InitialForwardDirection;
     APlayerPawnBoomerang* PlayerRef = nullptr;
 
+    // Client-side copy of a server throw, never awards score
+    bool bCosmetic = false;
+
+    // Grounded boomerang holding one of the limited physics settle slots
+    bool bHasSimulationSlot = false;
+
+    // Frees the slot of a body that never falls asleep
+    FTimerHandle SettleTimeoutHandle;
+
+    // Baked settle animation, used when no physics slot is free
+    bool bPlayingBakedTumble = false;
+    float TumbleTime = 0.f;
+    FVector TumbleOrigin;
+    FVector TumbleNormal;
+    FVector TumbleSlideDir;
+    FRotator TumbleRotation;
+
+    // Last movement along the path, used to slide the baked tumble
+    FVector FlightDirection = FVector::ZeroVector;
+
+    // Target whose bounding sphere the path enters at Alpha. From there each frame's move is swept
+    // against the target's own collision, the hit fires on contact and is dropped once the flight leaves the sphere.
+    struct FScheduledHit
+    {
+        TWeakObjectPtr<ABoomerangTarget> Target;
+        float Alpha = 0.f;
+    };
+
+    // Hits are scheduled on the flight timeline instead of swept every frame
+    bool bScheduledHits = false;
+    TArray<FScheduledHit> ScheduledHits;
+
+    // First wall along the path, WallAlpha is above 1 when the path is clear
+    float WallAlpha = 2.f;
+    FHitResult WallHit;
+
+    // Director's spawn count when targets were scheduled, a change means new targets to check
+    uint32 ScheduledTargetSpawns = 0;
+
+    // One batched pass over the path against world static geometry
+    void ScheduleWallHit();
+
+    // Sweeps the rest of the path, from FromAlpha on, against every live target
+    void ScheduleTargetHits(float FromAlpha);
+
+    // Pops the target and, on the server, awards the score
+    void HitTarget(ABoomerangTarget* Target);
+
+    // Called on a ground/wall impact
+    void BeginSettling(const FHitResult& Hit);
+    void TickBakedTumble(float DeltaTime);
+    void ReleaseSimulationSlot();
+
+    // Stops simulating and frees the slot, on sleep or timeout
+    void EndSimulatedSettle();
+
+    UFUNCTION()
+    void OnSettleSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
 public:
     UPROPERTY(EditAnywhere, Category = "Boomerang")
     float Distance = 1000.f;
@@ -54,12 +118,22 @@ public:
     UPROPERTY(EditAnywhere, Category = "Boomerang")
     float CurveRadius = 300.f;
 
+    // Path shape, the built-in loop when unset. Must be listed in the project's TrajectoryShapes.
+    UPROPERTY(EditAnywhere, Category = "Boomerang")
+    TObjectPtr<UBoomerangTrajectoryShape> TrajectoryShape;
+
     // Initialize with direction for physics-driven flight
     void InitializeBoomerang(const FVector& Direction, APlayerPawnBoomerang* Player);
 
     // Initialize using precomputed path points
     void InitializeWithPath(const TArray<FVector>& InPath, APlayerPawnBoomerang* Player);
 
+    // Initialize from a replicated throw descriptor
+    void InitializeFromDescriptor(const FBoomerangThrowDescriptor& Descriptor, APlayerPawnBoomerang* Player, bool bInCosmetic);
+
+    float GetTotalFlightTime() const { return TotalFlightTime; }
+    float GetSweepRadius() const { return SweepRadius; }
+
     // Called on collision
     UFUNCTION()
     void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
@@ -0,0 +1,99 @@
+// BoomerangBotController.cpp
+
+#include "BoomerangBotController.h"
+#include "BoomerangStats.h"
+#include "BoomerangActor.h"
+#include "BoomerangTarget.h"
+#include "PlayerPawnBoomerang.h"
+#include "BoomerangTrajectoryLibrary.h"
+#include "EngineUtils.h"
+
+
+ABoomerangBotController::ABoomerangBotController()
+{
+    PrimaryActorTick.bCanEverTick = true;
+}
+
+
+void ABoomerangBotController::OnPossess(APawn* InPawn)
+{
+    Super::OnPossess(InPawn);
+
+    BotPawn = Cast<APlayerPawnBoomerang>(InPawn);
+    if (!BotPawn) return;
+
+    PickStream.Initialize(RandomSeed != 0 ? RandomSeed : FMath::Rand());
+
+    // Use the exact quantized values the pawn throws with
+    const FBoomerangThrowDescriptor Descriptor = BotPawn->MakeThrowDescriptor(FRotator::ZeroRotator);
+    Solver.Initialize(Descriptor.Distance, Descriptor.CurveRadius, Descriptor.NumSegments, UBoomerangTrajectoryLibrary::GetTable(Descriptor.Shape));
+
+    AimTolerance = 12.f;
+    if (TSubclassOf<ABoomerangActor> BoomerangClass = BotPawn->GetBoomerangClass())
+    {
+        AimTolerance = BoomerangClass->GetDefaultObject<ABoomerangActor>()->GetSweepRadius();
+    }
+}
+
+
+void ABoomerangBotController::OnUnPossess()
+{
+    BotPawn = nullptr;
+
+    Super::OnUnPossess();
+}
+
+
+void ABoomerangBotController::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!BotPawn || BotPawn->HasActiveBoomerang())
+    {
+        TimeSinceThrow = 0.f;
+        return;
+    }
+
+    TimeSinceThrow += DeltaTime;
+    if (TimeSinceThrow < ThrowCooldown) return;
+
+    FRotator Aim;
+    if (PickAim(Aim))
+    {
+        BotPawn->SetAimRotation(Aim);
+        BotPawn->ThrowBoomerang();
+        TimeSinceThrow = 0.f;
+    }
+}
+
+
+bool ABoomerangBotController::PickAim(FRotator& OutAim)
+{
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_BotPickAim);
+
+    TArray<ABoomerangTarget*, TInlineAllocator<32>> Targets;
+    for (TActorIterator<ABoomerangTarget> It(GetWorld()); It; ++It)
+    {
+        Targets.Add(*It);
+    }
+
+    if (Targets.Num() == 0) return false;
+
+    // Start at a random target so bots don't all chase the same one
+    // Throws start from the rounded pawn location (see FBoomerangThrowDescriptor::Make)
+    const FVector Start = BotPawn->GetActorLocation().RoundToVector();
+    const int32 First = PickStream.RandHelper(Targets.Num());
+
+    for (int32 i = 0; i < Targets.Num(); ++i)
+    {
+        const ABoomerangTarget* Target = Targets[(First + i) % Targets.Num()];
+
+        float PathAlpha = 0.f;
+        if (Solver.Solve(Start, Target->GetActorLocation(), AimTolerance, OutAim, PathAlpha))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,55 @@
+// BoomerangBotController.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "BoomerangAimSolver.h"
+#include "BoomerangBotController.generated.h"
+
+class APlayerPawnBoomerang;
+
+// Drives an APlayerPawnBoomerang for load tests: picks a live target,
+// solves for an aim whose path hits it and throws.
+UCLASS()
+class SATJAM_BOOMERANG_API ABoomerangBotController : public AAIController
+{
+    GENERATED_BODY()
+
+public:
+    ABoomerangBotController();
+
+    virtual void Tick(float DeltaTime) override;
+
+    // Seed for target picking, takes effect on the next possess
+    void SetRandomSeed(int32 NewSeed) { RandomSeed = NewSeed; }
+
+protected:
+    virtual void OnPossess(APawn* InPawn) override;
+    virtual void OnUnPossess() override;
+
+private:
+    // Seconds to wait after the last boomerang returns before throwing again
+    UPROPERTY(EditAnywhere, Category = "Bot")
+    float ThrowCooldown = 0.25f;
+
+    // Seed for target picking, 0 picks a new seed
+    UPROPERTY(EditAnywhere, Category = "Bot")
+    int32 RandomSeed = 0;
+
+    UPROPERTY()
+    APlayerPawnBoomerang* BotPawn = nullptr;
+
+    // Path table for the possessed pawn's throw parameters
+    FBoomerangAimSolver Solver;
+
+    // Max miss distance that still sweeps the target
+    float AimTolerance = 0.f;
+
+    float TimeSinceThrow = 0.f;
+
+    FRandomStream PickStream;
+
+    // Finds a reachable live target and the aim that hits it
+    bool PickAim(FRotator& OutAim);
+};
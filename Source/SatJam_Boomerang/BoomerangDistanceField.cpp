@@ -0,0 +1,107 @@
+// BoomerangDistanceField.cpp
+
+#include "BoomerangDistanceField.h"
+
+namespace BoomerangDistanceField
+{
+    // Gives up and asks for a physics sweep after this many steps
+    constexpr int32 MaxTraceSteps = 48;
+}
+
+
+float UBoomerangDistanceField::SampleDistance(const FVector& Point, EDistanceFieldBrick& OutFlags) const
+{
+    OutFlags = EDistanceFieldBrick::None;
+
+    const float Band = GetBand();
+    const FVector Local = (Point - FieldMin) / VoxelSize;
+    const FVector FieldCells = FVector(NumBricks) * BrickCells;
+
+    // Geometry is at least a brick inside the field, so outside it the distance to the box plus a brick is safe
+    if (Local.X < 0.f || Local.Y < 0.f || Local.Z < 0.f || Local.X >= FieldCells.X || Local.Y >= FieldCells.Y || Local.Z >= FieldCells.Z)
+    {
+        const FBox FieldBox(FieldMin, FieldMin + FieldCells * VoxelSize);
+        return FMath::Sqrt(FieldBox.ComputeSquaredDistanceToPoint(Point)) + Band;
+    }
+
+    const FIntVector Brick(
+        FMath::Min(FMath::FloorToInt32(Local.X / BrickCells), NumBricks.X - 1),
+        FMath::Min(FMath::FloorToInt32(Local.Y / BrickCells), NumBricks.Y - 1),
+        FMath::Min(FMath::FloorToInt32(Local.Z / BrickCells), NumBricks.Z - 1));
+
+    const int32 Slot = BrickSlots[Brick.X + NumBricks.X * (Brick.Y + NumBricks.Y * Brick.Z)];
+    if (Slot == INDEX_NONE) return Band;
+
+    OutFlags = static_cast<EDistanceFieldBrick>(BrickFlags[Slot]);
+
+    // Trilinear between the 8 samples around the point, all inside this brick
+    const FVector InBrick = Local - FVector(Brick * BrickCells);
+    const int32 X = FMath::Min(FMath::FloorToInt32(InBrick.X), BrickCells - 1);
+    const int32 Y = FMath::Min(FMath::FloorToInt32(InBrick.Y), BrickCells - 1);
+    const int32 Z = FMath::Min(FMath::FloorToInt32(InBrick.Z), BrickCells - 1);
+    const float FX = InBrick.X - X;
+    const float FY = InBrick.Y - Y;
+    const float FZ = InBrick.Z - Z;
+
+    const uint8* S = &Samples[Slot * SamplesPerBrick + X + BrickSamples * (Y + BrickSamples * Z)];
+    constexpr int32 DY = BrickSamples;
+    constexpr int32 DZ = BrickSamples * BrickSamples;
+
+    const float C00 = FMath::Lerp<float>(S[0], S[1], FX);
+    const float C10 = FMath::Lerp<float>(S[DY], S[DY + 1], FX);
+    const float C01 = FMath::Lerp<float>(S[DZ], S[DZ + 1], FX);
+    const float C11 = FMath::Lerp<float>(S[DZ + DY], S[DZ + DY + 1], FX);
+    const float Value = FMath::Lerp(FMath::Lerp(C00, C10, FY), FMath::Lerp(C01, C11, FY), FZ);
+
+    return Value * (Band / 255.f);
+}
+
+
+FVector UBoomerangDistanceField::SampleNormal(const FVector& Point) const
+{
+    const float H = VoxelSize * 0.5f;
+    EDistanceFieldBrick Flags;
+
+    const FVector Gradient(
+        SampleDistance(Point + FVector(H, 0, 0), Flags) - SampleDistance(Point - FVector(H, 0, 0), Flags),
+        SampleDistance(Point + FVector(0, H, 0), Flags) - SampleDistance(Point - FVector(0, H, 0), Flags),
+        SampleDistance(Point + FVector(0, 0, H), Flags) - SampleDistance(Point - FVector(0, 0, H), Flags));
+
+    return Gradient.GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+}
+
+
+EDistanceFieldTrace UBoomerangDistanceField::SphereTrace(const FVector& Start, const FVector& End, float Radius, float& OutTime) const
+{
+    const FVector Delta = End - Start;
+    const float Length = Delta.Size();
+
+    // Never step less than a quarter voxel, interpolation error is about that size anyway
+    const float MinStep = VoxelSize * 0.25f;
+    float Travelled = 0.f;
+
+    for (int32 Step = 0; Step < BoomerangDistanceField::MaxTraceSteps; ++Step)
+    {
+        const float Time = Length > UE_KINDA_SMALL_NUMBER ? Travelled / Length : 0.f;
+
+        EDistanceFieldBrick Flags;
+        const float Distance = SampleDistance(Start + Delta * Time, Flags);
+
+        // Collision that may have moved since the bake, or was never measured, can be anywhere in its bricks
+        if (EnumHasAnyFlags(Flags, EDistanceFieldBrick::Unbaked | EDistanceFieldBrick::Unmeasured)) return EDistanceFieldTrace::NeedsPhysics;
+
+        // A wall thinner than a voxel can hide between samples
+        if (EnumHasAnyFlags(Flags, EDistanceFieldBrick::Thin) && Distance < Radius + VoxelSize) return EDistanceFieldTrace::NeedsPhysics;
+
+        if (Distance <= Radius)
+        {
+            OutTime = Time;
+            return EDistanceFieldTrace::Hit;
+        }
+
+        Travelled += FMath::Max(Distance - Radius, MinStep);
+        if (Travelled >= Length) return EDistanceFieldTrace::Clear;
+    }
+
+    return EDistanceFieldTrace::NeedsPhysics;
+}
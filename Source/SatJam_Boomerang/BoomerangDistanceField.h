@@ -0,0 +1,82 @@
+// BoomerangDistanceField.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "BoomerangDistanceField.generated.h"
+
+// Why traces near a stored brick must fall back to physics
+enum class EDistanceFieldBrick : uint8
+{
+    None = 0,
+    Thin = 1 << 0,          // collision shapes thinner than ThinThreshold, they can slip between samples
+    Unbaked = 1 << 1,       // Stationary or Movable collision, its baked position may be stale
+    Unmeasured = 1 << 2,    // triangle mesh or heightfield collision the bake couldn't measure, the samples don't see it
+};
+ENUM_CLASS_FLAGS(EDistanceFieldBrick)
+
+enum class EDistanceFieldTrace : uint8
+{
+    Clear,          // nothing along the segment
+    Hit,            // sphere touches static geometry at OutTime
+    NeedsPhysics,   // near geometry the field can't answer for, sweep with physics instead
+};
+
+
+// Sparse distance field of a level's static collision, baked by the BakeDistanceField commandlet.
+// Space is split into bricks of BrickCells^3 voxels; only bricks within one brick of geometry are stored,
+// as BrickSamples^3 corner samples quantized to a byte, so a brick interpolates without its neighbours.
+UCLASS(BlueprintType)
+class SATJAM_BOOMERANG_API UBoomerangDistanceField : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 BrickCells = 8;
+    static constexpr int32 BrickSamples = BrickCells + 1;
+    static constexpr int32 SamplesPerBrick = BrickSamples * BrickSamples * BrickSamples;
+
+    UPROPERTY(VisibleAnywhere, Category = "Field")
+    float VoxelSize = 25.f;
+
+    // World space corner of brick (0, 0, 0)
+    UPROPERTY(VisibleAnywhere, Category = "Field")
+    FVector FieldMin = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, Category = "Field")
+    FIntVector NumBricks = FIntVector::ZeroValue;
+
+    // Stored brick per grid brick, INDEX_NONE where no geometry is within one brick
+    UPROPERTY()
+    TArray<int32> BrickSlots;
+
+    // SamplesPerBrick bytes per stored brick, 0..255 maps to 0..GetBand()
+    UPROPERTY()
+    TArray<uint8> Samples;
+
+    // EDistanceFieldBrick flags per stored brick
+    UPROPERTY()
+    TArray<uint8> BrickFlags;
+
+    // Collision thinner than this can slip between samples
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    float ThinThreshold = 0.f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    int32 NumComponents = 0;
+
+    // Largest distance the samples encode, and the guaranteed clearance of an empty brick
+    float GetBand() const { return VoxelSize * BrickCells; }
+
+    int32 GetNumStoredBricks() const { return BrickFlags.Num(); }
+
+    // Distance to the nearest static collision (0 inside), capped at GetBand(). Safe from any thread.
+    float SampleDistance(const FVector& Point, EDistanceFieldBrick& OutFlags) const;
+
+    // Direction away from the nearest geometry
+    FVector SampleNormal(const FVector& Point) const;
+
+    // Sphere traces the field from Start to End, OutTime is the fraction of the move at contact
+    EDistanceFieldTrace SphereTrace(const FVector& Start, const FVector& End, float Radius, float& OutTime) const;
+};
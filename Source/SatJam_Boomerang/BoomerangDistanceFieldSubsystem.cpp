@@ -0,0 +1,132 @@
+// BoomerangDistanceFieldSubsystem.cpp
+
+#include "BoomerangDistanceFieldSubsystem.h"
+#include "BoomerangDistanceField.h"
+#include "BoomerangSettings.h"
+#include "BoomerangStats.h"
+#include "SatJam_Boomerang.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+
+
+bool UBoomerangDistanceFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UBoomerangDistanceFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // PIE worlds live in a prefixed copy of the map package
+    const FString MapName = UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+
+    for (const TPair<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UBoomerangDistanceField>>& Pair : GetDefault<UBoomerangSettings>()->ArenaDistanceFields)
+    {
+        if (Pair.Key.ToSoftObjectPath().GetLongPackageName() != MapName) continue;
+
+        Field = Pair.Value.LoadSynchronous();
+        break;
+    }
+
+    if (Field)
+    {
+        UE_LOG(LogBoomerang, Log, TEXT("Static sweeps in %s use %s (%d bricks)"), *MapName, *Field->GetName(), Field->GetNumStoredBricks());
+
+        ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UBoomerangDistanceFieldSubsystem::OnActorSpawned));
+        ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UBoomerangDistanceFieldSubsystem::OnActorDestroyed));
+    }
+}
+
+
+void UBoomerangDistanceFieldSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+    }
+
+    Super::Deinitialize();
+}
+
+
+void UBoomerangDistanceFieldSubsystem::OnActorSpawned(AActor* Actor)
+{
+    // Same filter as the bake, boomerangs and targets use other channels and never get here
+    FBox Bounds(ForceInit);
+    TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+    for (const UPrimitiveComponent* Component : Components)
+    {
+        if (Component->IsRegistered() && Component->IsQueryCollisionEnabled() && Component->GetCollisionObjectType() == ECC_WorldStatic)
+        {
+            Bounds += Component->Bounds.GetBox();
+        }
+    }
+
+    if (!Bounds.IsValid) return;
+
+    FWriteScopeLock Lock(RuntimeStaticLock);
+    RuntimeStaticBounds.Add(Actor->GetUniqueID(), Bounds);
+}
+
+
+void UBoomerangDistanceFieldSubsystem::OnActorDestroyed(AActor* Actor)
+{
+    FWriteScopeLock Lock(RuntimeStaticLock);
+    RuntimeStaticBounds.Remove(Actor->GetUniqueID());
+}
+
+
+bool UBoomerangDistanceFieldSubsystem::SweepStatic(const FVector& Start, const FVector& End, float Radius, FHitResult& OutHit) const
+{
+    bool bNearRuntimeStatic = false;
+    if (Field)
+    {
+        const FBox SweepBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(Radius);
+
+        FReadScopeLock Lock(RuntimeStaticLock);
+        for (const TPair<uint32, FBox>& Pair : RuntimeStaticBounds)
+        {
+            if (Pair.Value.Intersect(SweepBounds))
+            {
+                bNearRuntimeStatic = true;
+                break;
+            }
+        }
+    }
+
+    if (Field && !bNearRuntimeStatic)
+    {
+        INC_DWORD_STAT(STAT_DistanceFieldSweeps);
+
+        float Time = 1.f;
+        const EDistanceFieldTrace Result = Field->SphereTrace(Start, End, Radius, Time);
+
+        if (Result == EDistanceFieldTrace::Clear) return false;
+
+        if (Result == EDistanceFieldTrace::Hit)
+        {
+            OutHit = FHitResult(Start, End);
+            OutHit.bBlockingHit = true;
+            OutHit.Time = Time;
+            OutHit.Distance = (End - Start).Size() * Time;
+            OutHit.Location = Start + (End - Start) * Time;
+            OutHit.Normal = Field->SampleNormal(OutHit.Location);
+            OutHit.ImpactNormal = OutHit.Normal;
+            OutHit.ImpactPoint = OutHit.Location - OutHit.Normal * Radius;
+            return true;
+        }
+    }
+
+    INC_DWORD_STAT(STAT_PhysicsFallbackSweeps);
+
+    // Scene queries take the physics read lock, so this is safe off the game thread too
+    const FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+    const FCollisionQueryParams Params(SCENE_QUERY_STAT(BoomerangSweepStatic), false);
+
+    return GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, Sphere, Params);
+}
@@ -0,0 +1,46 @@
+// BoomerangDistanceFieldSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Misc/ScopeRWLock.h"
+#include "BoomerangDistanceFieldSubsystem.generated.h"
+
+class UBoomerangDistanceField;
+
+// Answers sphere sweeps against the level's static collision. Uses the map's baked UBoomerangDistanceField
+// (UBoomerangSettings::ArenaDistanceFields) where it can, and a physics sweep near thin or movable geometry,
+// near static props spawned after the bake, or without a field.
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangDistanceFieldSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // First blocking static hit of a sphere moved from Start to End. Safe from any thread.
+    bool SweepStatic(const FVector& Start, const FVector& End, float Radius, FHitResult& OutHit) const;
+
+    const UBoomerangDistanceField* GetField() const { return Field; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    // Static collision spawned at runtime isn't in the field, sweeps near it use physics
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+
+    UPROPERTY()
+    TObjectPtr<UBoomerangDistanceField> Field;
+
+    // Bounds of runtime-spawned WorldStatic collision by actor, read by worker sweeps
+    TMap<uint32, FBox> RuntimeStaticBounds;
+    mutable FRWLock RuntimeStaticLock;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+};
@@ -0,0 +1,213 @@
+// BoomerangHeatmap.cpp
+
+#include "BoomerangHeatmap.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace BoomerangHeatmap
+{
+    constexpr uint32 Magic = 0x504D4842; // "BHMP"
+    constexpr uint32 Version = 1;
+
+    // Count of non-zero cells followed by (index, count) pairs
+    static void SerializeSparse(FArchive& Ar, TArray<uint32>& Cells)
+    {
+        if (Ar.IsLoading())
+        {
+            int32 NumSet = 0;
+            Ar << NumSet;
+            for (int32 i = 0; i < NumSet && !Ar.IsError(); ++i)
+            {
+                int32 Index = 0;
+                uint32 Count = 0;
+                Ar << Index << Count;
+
+                if (!Cells.IsValidIndex(Index))
+                {
+                    Ar.SetError();
+                    return;
+                }
+                Cells[Index] = Count;
+            }
+            return;
+        }
+
+        int32 NumSet = 0;
+        for (uint32 Count : Cells)
+        {
+            NumSet += Count != 0;
+        }
+
+        Ar << NumSet;
+        for (int32 Index = 0; Index < Cells.Num(); ++Index)
+        {
+            if (Cells[Index] != 0)
+            {
+                Ar << Index << Cells[Index];
+            }
+        }
+    }
+
+    static void AddCells(TArray<uint32>& Into, const TArray<uint32>& From)
+    {
+        for (int32 i = 0; i < Into.Num(); ++i)
+        {
+            Into[i] += From[i];
+        }
+    }
+}
+
+
+void FBoomerangHeatmap::Init(const FBoomerangHeatmapLayout& InLayout)
+{
+    Layout = InLayout;
+    NumSessions = 0;
+    NumOutside = 0;
+
+    const int32 NumXY = Layout.CellsXY * Layout.CellsXY;
+    ThrowDirections.SetNumZeroed(Layout.YawBins * Layout.PitchBins);
+    GroundImpacts.SetNumZeroed(NumXY);
+    TargetHits.SetNumZeroed(NumXY * Layout.CellsZ);
+    TargetExpires.SetNumZeroed(NumXY * Layout.CellsZ);
+}
+
+
+int32 FBoomerangHeatmap::GetCellXY(const FVector& Location) const
+{
+    const float HalfExtent = 0.5f * Layout.CellSize * Layout.CellsXY;
+    const int32 X = FMath::FloorToInt32((Location.X + HalfExtent) / Layout.CellSize);
+    const int32 Y = FMath::FloorToInt32((Location.Y + HalfExtent) / Layout.CellSize);
+
+    if (X < 0 || Y < 0 || X >= Layout.CellsXY || Y >= Layout.CellsXY) return INDEX_NONE;
+    return Y * Layout.CellsXY + X;
+}
+
+
+int32 FBoomerangHeatmap::GetCellXYZ(const FVector& Location) const
+{
+    const int32 CellXY = GetCellXY(Location);
+    const int32 Z = FMath::FloorToInt32(Location.Z / Layout.CellSize);
+
+    if (CellXY == INDEX_NONE || Z < 0 || Z >= Layout.CellsZ) return INDEX_NONE;
+    return Z * Layout.CellsXY * Layout.CellsXY + CellXY;
+}
+
+
+void FBoomerangHeatmap::AddThrow(const FRotator& Aim)
+{
+    const float Yaw = FRotator::ClampAxis(Aim.Yaw);
+    const float Pitch = FMath::Clamp(FRotator::NormalizeAxis(Aim.Pitch), -90.f, 90.f);
+
+    const int32 YawBin = FMath::Min(FMath::FloorToInt32(Yaw / 360.f * Layout.YawBins), Layout.YawBins - 1);
+    const int32 PitchBin = FMath::Min(FMath::FloorToInt32((Pitch + 90.f) / 180.f * Layout.PitchBins), Layout.PitchBins - 1);
+
+    ThrowDirections[PitchBin * Layout.YawBins + YawBin]++;
+}
+
+
+void FBoomerangHeatmap::AddGroundImpact(const FVector& Location)
+{
+    const int32 Cell = GetCellXY(Location);
+    if (Cell == INDEX_NONE)
+    {
+        NumOutside++;
+        return;
+    }
+
+    GroundImpacts[Cell]++;
+}
+
+
+void FBoomerangHeatmap::AddTarget(const FVector& Location, bool bHit)
+{
+    const int32 Cell = GetCellXYZ(Location);
+    if (Cell == INDEX_NONE)
+    {
+        NumOutside++;
+        return;
+    }
+
+    (bHit ? TargetHits : TargetExpires)[Cell]++;
+}
+
+
+bool FBoomerangHeatmap::Merge(const FBoomerangHeatmap& Other)
+{
+    using namespace BoomerangHeatmap;
+
+    if (!IsInitialized())
+    {
+        Init(Other.Layout);
+    }
+
+    if (!(Layout == Other.Layout) || !Other.IsInitialized()) return false;
+
+    NumSessions += Other.NumSessions;
+    NumOutside += Other.NumOutside;
+    AddCells(ThrowDirections, Other.ThrowDirections);
+    AddCells(GroundImpacts, Other.GroundImpacts);
+    AddCells(TargetHits, Other.TargetHits);
+    AddCells(TargetExpires, Other.TargetExpires);
+    return true;
+}
+
+
+FArchive& operator<<(FArchive& Ar, FBoomerangHeatmap& Heatmap)
+{
+    using namespace BoomerangHeatmap;
+
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = Version;
+    Ar << FileMagic << FileVersion;
+
+    if (FileMagic != Magic || FileVersion != Version)
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    FBoomerangHeatmapLayout& Layout = Heatmap.Layout;
+    Ar << Layout.CellSize << Layout.CellsXY << Layout.CellsZ << Layout.YawBins << Layout.PitchBins;
+
+    if (Ar.IsLoading())
+    {
+        // Refuse layouts that would allocate something absurd from a corrupt file
+        const bool bSane = Layout.CellSize > 0.f && Layout.CellsXY > 0 && Layout.CellsXY <= 4096 && Layout.CellsZ > 0 && Layout.CellsZ <= 256
+            && Layout.YawBins > 0 && Layout.YawBins <= 3600 && Layout.PitchBins > 0 && Layout.PitchBins <= 1800;
+        if (!bSane)
+        {
+            Ar.SetError();
+            return Ar;
+        }
+        Heatmap.Init(Layout);
+    }
+
+    Ar << Heatmap.NumSessions << Heatmap.NumOutside;
+    SerializeSparse(Ar, Heatmap.ThrowDirections);
+    SerializeSparse(Ar, Heatmap.GroundImpacts);
+    SerializeSparse(Ar, Heatmap.TargetHits);
+    SerializeSparse(Ar, Heatmap.TargetExpires);
+    return Ar;
+}
+
+
+bool FBoomerangHeatmap::SaveToFile(const FString& Path) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    Writer << const_cast<FBoomerangHeatmap&>(*this);
+
+    return !Writer.IsError() && FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+
+bool FBoomerangHeatmap::LoadFromFile(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)) return false;
+
+    FMemoryReader Reader(Bytes);
+    Reader << *this;
+    return !Reader.IsError();
+}
@@ -0,0 +1,57 @@
+// BoomerangHeatmap.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Grid sizes, files with different layouts can't be merged
+struct FBoomerangHeatmapLayout
+{
+    float CellSize = 100.f;     // world units per XY and Z cell, grids are centered on the world origin
+    int32 CellsXY = 128;
+    int32 CellsZ = 8;           // from z = 0 up
+    int32 YawBins = 72;         // 0..360
+    int32 PitchBins = 36;       // -90..90
+
+    bool operator==(const FBoomerangHeatmapLayout& Other) const
+    {
+        return CellSize == Other.CellSize && CellsXY == Other.CellsXY && CellsZ == Other.CellsZ
+            && YawBins == Other.YawBins && PitchBins == Other.PitchBins;
+    }
+};
+
+
+// Histogram grids of where players aim, where boomerangs land and where targets are hit or expire.
+// Recording is one increment, merging is an element-wise add, files store only non-zero cells.
+struct SATJAM_BOOMERANG_API FBoomerangHeatmap
+{
+    FBoomerangHeatmapLayout Layout;
+    uint32 NumSessions = 0;
+
+    // Events outside the grid, dropped rather than piled on the edge cells
+    uint32 NumOutside = 0;
+
+    TArray<uint32> ThrowDirections;     // PitchBins rows of YawBins
+    TArray<uint32> GroundImpacts;       // CellsXY rows of CellsXY
+    TArray<uint32> TargetHits;          // CellsZ layers of CellsXY x CellsXY
+    TArray<uint32> TargetExpires;       // same as TargetHits
+
+    void Init(const FBoomerangHeatmapLayout& InLayout);
+    bool IsInitialized() const { return ThrowDirections.Num() > 0; }
+
+    void AddThrow(const FRotator& Aim);
+    void AddGroundImpact(const FVector& Location);
+    void AddTarget(const FVector& Location, bool bHit);
+
+    // False when the layouts differ
+    bool Merge(const FBoomerangHeatmap& Other);
+
+    bool SaveToFile(const FString& Path) const;
+    bool LoadFromFile(const FString& Path);
+
+    friend FArchive& operator<<(FArchive& Ar, FBoomerangHeatmap& Heatmap);
+
+private:
+    int32 GetCellXY(const FVector& Location) const;
+    int32 GetCellXYZ(const FVector& Location) const;
+};
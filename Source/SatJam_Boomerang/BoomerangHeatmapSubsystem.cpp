@@ -0,0 +1,79 @@
+// BoomerangHeatmapSubsystem.cpp
+
+#include "BoomerangHeatmapSubsystem.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarHeatmap(
+    TEXT("boomerang.Heatmap"),
+    0,
+    TEXT("Record throw and hit heatmaps for worlds created after this is set (0 = off, 1 = on)."));
+
+
+bool UBoomerangHeatmapSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const bool bEnabled = CVarHeatmap.GetValueOnGameThread() != 0 || FParse::Param(FCommandLine::Get(), TEXT("boomerangheatmap"));
+    return bEnabled && Super::ShouldCreateSubsystem(Outer);
+}
+
+
+bool UBoomerangHeatmapSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UBoomerangHeatmapSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+
+    FBoomerangHeatmapLayout Layout;
+    Layout.CellSize = Settings->HeatmapCellSize;
+    Layout.CellsXY = Settings->HeatmapCellsXY;
+    Layout.CellsZ = Settings->HeatmapCellsZ;
+    Heatmap.Init(Layout);
+
+    OutputDir = FPaths::ProjectSavedDir() / TEXT("Heatmaps");
+    FParse::Value(FCommandLine::Get(), TEXT("heatmapdir="), OutputDir);
+}
+
+
+void UBoomerangHeatmapSubsystem::Deinitialize()
+{
+    // Quitting mid-session still keeps what was recorded
+    EndSession();
+    WritePipe.WaitUntilEmpty();
+
+    Super::Deinitialize();
+}
+
+
+void UBoomerangHeatmapSubsystem::EndSession()
+{
+    if (!bDirty) return;
+    bDirty = false;
+
+    FBoomerangHeatmap Session = MoveTemp(Heatmap);
+    Session.NumSessions = 1;
+    Heatmap.Init(Session.Layout);
+
+    // Unique across worlds and processes, batch runs write into one directory
+    const FString Path = OutputDir / FString::Printf(TEXT("Heatmap_%s.bhm"), *FGuid::NewGuid().ToString());
+
+    WritePipe.Launch(TEXT("SaveHeatmap"),
+        [Path, Session = MoveTemp(Session)]()
+        {
+            FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(Path));
+            if (!Session.SaveToFile(Path))
+            {
+                UE_LOG(LogBoomerang, Error, TEXT("Failed to save heatmap to %s"), *Path);
+            }
+        });
+}
@@ -0,0 +1,42 @@
+// BoomerangHeatmapSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Pipe.h"
+#include "BoomerangHeatmap.h"
+#include "BoomerangHeatmapSubsystem.generated.h"
+
+// Bins throws, ground impacts and target outcomes into an in-memory FBoomerangHeatmap.
+// Nothing is written per event, each finished session is saved on a worker thread to
+// Saved/Heatmaps (or -heatmapdir=<dir>). Enable with -boomerangheatmap or boomerang.Heatmap 1.
+// Merge the files with -run=MergeHeatmaps.
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangHeatmapSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    void RecordThrow(const FRotator& Aim) { Heatmap.AddThrow(Aim); bDirty = true; }
+    void RecordGroundImpact(const FVector& Location) { Heatmap.AddGroundImpact(Location); bDirty = true; }
+    void RecordTarget(const FVector& Location, bool bHit) { Heatmap.AddTarget(Location, bHit); bDirty = true; }
+
+    // Hands the session's grids to a worker thread to save and starts a fresh set
+    void EndSession();
+
+protected:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    FBoomerangHeatmap Heatmap;
+    FString OutputDir;
+    bool bDirty = false;
+
+    // Keeps saves ordered and lets Deinitialize wait for them
+    UE::Tasks::FPipe WritePipe{ TEXT("BoomerangHeatmap") };
+};
@@ -0,0 +1,53 @@
+// BoomerangMemory.cpp
+
+#include "BoomerangMemory.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangTarget.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+LLM_DEFINE_TAG(Boomerang);
+LLM_DEFINE_TAG(Boomerang_Targets);
+LLM_DEFINE_TAG(Boomerang_Trajectory);
+LLM_DEFINE_TAG(Boomerang_GameUI);
+
+
+static FAutoConsoleCommandWithWorld MemReportCommand(
+    TEXT("boomerang.MemReport"),
+    TEXT("Logs current and peak LLM memory for the Boomerang tags (needs -llm)."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+        if (!FLowLevelMemTracker::IsEnabled())
+        {
+            UE_LOG(LogBoomerang, Display, TEXT("LLM is off, run with -llm to collect the Boomerang tags."));
+            return;
+        }
+
+        // Unique tag names, underscores in the declarations become slashes
+        static const TCHAR* TagNames[] = { TEXT("Boomerang"), TEXT("Boomerang/Targets"), TEXT("Boomerang/Trajectory"), TEXT("Boomerang/GameUI") };
+
+        int32 NumTargets = 0;
+        for (TActorIterator<ABoomerangTarget> It(World); It; ++It)
+        {
+            NumTargets++;
+        }
+
+        FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+        for (const TCHAR* TagName : TagNames)
+        {
+            const int64 Current = Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TagName), ELLMTagSet::None, UE::LLM::ESizeParams::ReportCurrent);
+            const int64 Peak = Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TagName), ELLMTagSet::None, UE::LLM::ESizeParams::ReportPeak);
+            UE_LOG(LogBoomerang, Display, TEXT("%-22s current %8.1f KB  peak %8.1f KB"), TagName, Current / 1024.0, Peak / 1024.0);
+        }
+
+        // Per-target cost is what scales with arena size
+        if (NumTargets > 0)
+        {
+            const int64 TargetBytes = Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TEXT("Boomerang/Targets")), ELLMTagSet::None, UE::LLM::ESizeParams::ReportCurrent);
+            UE_LOG(LogBoomerang, Display, TEXT("%d live targets, %.1f KB per target"), NumTargets, TargetBytes / 1024.0 / NumTargets);
+        }
+#else
+        UE_LOG(LogBoomerang, Display, TEXT("LLM is compiled out of this build."));
+#endif
+    }));
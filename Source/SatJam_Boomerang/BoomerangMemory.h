@@ -0,0 +1,13 @@
+// BoomerangMemory.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Low-level memory tags for the game module, run with -llm to collect them.
+// boomerang.MemReport logs current and peak bytes per tag.
+LLM_DECLARE_TAG_API(Boomerang, SATJAM_BOOMERANG_API);               // boomerang actors and their flight paths
+LLM_DECLARE_TAG_API(Boomerang_Targets, SATJAM_BOOMERANG_API);       // spawned targets and spawner bookkeeping
+LLM_DECLARE_TAG_API(Boomerang_Trajectory, SATJAM_BOOMERANG_API);    // aim preview spline
+LLM_DECLARE_TAG_API(Boomerang_GameUI, SATJAM_BOOMERANG_API);        // HUD widgets
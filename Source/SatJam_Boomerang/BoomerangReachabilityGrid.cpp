@@ -0,0 +1,14 @@
+// BoomerangReachabilityGrid.cpp
+
+#include "BoomerangReachabilityGrid.h"
+
+
+FVector UBoomerangReachabilityGrid::GetCellCenter(int32 ReachableIndex) const
+{
+    const int32 Cell = CellIndices[ReachableIndex];
+    const int32 X = Cell % Dims.X;
+    const int32 Y = (Cell / Dims.X) % Dims.Y;
+    const int32 Z = Cell / (Dims.X * Dims.Y);
+
+    return GridMin + (FVector(X, Y, Z) + 0.5) * CellSize;
+}
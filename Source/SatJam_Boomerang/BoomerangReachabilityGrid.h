@@ -0,0 +1,57 @@
+// BoomerangReachabilityGrid.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "BoomerangReachabilityGrid.generated.h"
+
+// Cells a boomerang can reach from its throw origin, and how much of the aim space reaches each one.
+// Baked by the BakeReachability commandlet, positions are relative to the throw origin.
+UCLASS(BlueprintType)
+class SATJAM_BOOMERANG_API UBoomerangReachabilityGrid : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Cell size in world units
+    UPROPERTY(VisibleAnywhere, Category = "Grid")
+    float CellSize = 50.f;
+
+    // Corner of cell (0, 0, 0) relative to the throw origin
+    UPROPERTY(VisibleAnywhere, Category = "Grid")
+    FVector GridMin = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, Category = "Grid")
+    FIntVector Dims = FIntVector::ZeroValue;
+
+    // Reachable cells only, as linear indices into the grid
+    UPROPERTY()
+    TArray<int32> CellIndices;
+
+    // Fraction of the baked aims that hit a target centred in the matching cell
+    UPROPERTY()
+    TArray<float> HitProbability;
+
+    // Throw the grid was baked for, so a stale bake can be spotted
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    float Distance = 0.f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    float CurveRadius = 0.f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    int32 NumSegments = 0;
+
+    // Boomerang sweep radius plus target radius
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    float HitRadius = 0.f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    int32 NumAims = 0;
+
+    int32 GetNumReachableCells() const { return CellIndices.Num(); }
+
+    // Centre of a reachable cell, relative to the throw origin
+    FVector GetCellCenter(int32 ReachableIndex) const;
+};
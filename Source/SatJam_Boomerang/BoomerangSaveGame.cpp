@@ -0,0 +1,48 @@
+// BoomerangSaveGame.cpp
+
+#include "BoomerangSaveGame.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+
+FArchive& operator<<(FArchive& Ar, FBoomerangSessionRecord& Record)
+{
+    uint8 Version = FBoomerangSessionRecord::CurrentVersion;
+    Ar << Version;
+
+    // Records from a newer build can't be read safely
+    if (Ar.IsLoading() && Version > FBoomerangSessionRecord::CurrentVersion)
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    Ar << Record.Score;
+    Ar << Record.Duration;
+    Ar << Record.Throws;
+    Ar << Record.Hits;
+    Ar << Record.Seed;
+    Ar << Record.Timestamp;
+    return Ar;
+}
+
+
+void FBoomerangSessionRecord::WriteTo(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset(RecordSize);
+
+    FMemoryWriter Writer(OutBytes);
+    Writer << const_cast<FBoomerangSessionRecord&>(*this);
+
+    check(OutBytes.Num() <= RecordSize);
+    OutBytes.SetNumZeroed(RecordSize); // pad to the fixed slot size
+}
+
+
+bool FBoomerangSessionRecord::ReadFrom(const uint8* Bytes)
+{
+    TArray<uint8> Slot(Bytes, RecordSize);
+    FMemoryReader Reader(Slot);
+    Reader << *this;
+    return !Reader.IsError();
+}
@@ -0,0 +1,49 @@
+// BoomerangSaveGame.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "BoomerangSaveGame.generated.h"
+
+// One finished session, stored as a small fixed-size binary record
+struct FBoomerangSessionRecord
+{
+    // Bump when fields are added, older records keep loading
+    static constexpr uint8 CurrentVersion = 1;
+
+    // Bytes reserved per record in the history file (room for future fields)
+    static constexpr int32 RecordSize = 32;
+
+    int32 Score = 0;
+    float Duration = 0.f;
+    uint16 Throws = 0;
+    uint16 Hits = 0;
+    int32 Seed = 0;
+    int64 Timestamp = 0;    // UTC ticks when the session ended
+
+    friend FArchive& operator<<(FArchive& Ar, FBoomerangSessionRecord& Record);
+
+    // Write into / read from a RecordSize byte slot
+    void WriteTo(TArray<uint8>& OutBytes) const;
+    bool ReadFrom(const uint8* Bytes);
+};
+
+
+// Small save object holding only the best score, saved with AsyncSaveGameToSlot
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangSaveGame : public USaveGame
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    uint8 FormatVersion = FBoomerangSessionRecord::CurrentVersion;
+
+    UPROPERTY()
+    int32 HighScore = 0;
+
+    // Packed record of the session that set the high score
+    UPROPERTY()
+    TArray<uint8> HighScoreRecord;
+};
@@ -0,0 +1,159 @@
+// BoomerangScoreSubsystem.cpp
+
+#include "BoomerangScoreSubsystem.h"
+#include "SatJam_Boomerang.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+const FString UBoomerangScoreSubsystem::SlotName = TEXT("BoomerangHighScore");
+
+namespace BoomerangHistory
+{
+    // Header at the start of the history file, followed by HistoryCapacity fixed-size records
+    constexpr uint32 Magic = 0x48524D42; // "BMRH"
+    constexpr int64 HeaderSize = 16;
+
+    struct FHeader
+    {
+        uint32 Magic = BoomerangHistory::Magic;
+        uint8 Version = FBoomerangSessionRecord::CurrentVersion;
+        uint8 RecordSize = FBoomerangSessionRecord::RecordSize;
+        uint16 Capacity = UBoomerangScoreSubsystem::HistoryCapacity;
+        uint32 Head = 0;    // next slot to write
+        uint32 Count = 0;   // valid records, capped at Capacity
+    };
+    static_assert(sizeof(FHeader) == HeaderSize, "History header must stay 16 bytes");
+}
+
+
+void UBoomerangScoreSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Load the high score in the background so startup isn't blocked, a missing slot comes back as null
+    UGameplayStatics::AsyncLoadGameFromSlot(SlotName, 0,
+        FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &UBoomerangScoreSubsystem::OnSaveLoaded));
+}
+
+
+void UBoomerangScoreSubsystem::Deinitialize()
+{
+    // Let queued history writes finish before quitting
+    HistoryPipe.WaitUntilEmpty();
+
+    Super::Deinitialize();
+}
+
+
+void UBoomerangScoreSubsystem::OnSaveLoaded(const FString& InSlotName, const int32 UserIndex, USaveGame* LoadedSave)
+{
+    SaveGame = Cast<UBoomerangSaveGame>(LoadedSave);
+    if (!SaveGame)
+    {
+        SaveGame = Cast<UBoomerangSaveGame>(UGameplayStatics::CreateSaveGameObject(UBoomerangSaveGame::StaticClass()));
+    }
+
+    HighScore = SaveGame->HighScore;
+    bLoaded = true;
+
+    UE_LOG(LogBoomerang, Log, TEXT("High score loaded: %d"), HighScore);
+
+    if (PendingRecord.IsSet())
+    {
+        FBoomerangSessionRecord Record = PendingRecord.GetValue();
+        PendingRecord.Reset();
+        RecordSession(Record);
+    }
+}
+
+
+void UBoomerangScoreSubsystem::RecordSession(const FBoomerangSessionRecord& Record)
+{
+    if (!bLoaded)
+    {
+        // Merge with the stored high score once it has been read
+        PendingRecord = Record;
+        return;
+    }
+
+    TArray<uint8> RecordBytes;
+    Record.WriteTo(RecordBytes);
+
+    // Only the tiny high score object goes through the save game system
+    if (Record.Score > HighScore)
+    {
+        HighScore = Record.Score;
+        SaveGame->HighScore = Record.Score;
+        SaveGame->HighScoreRecord = RecordBytes;
+
+        UGameplayStatics::AsyncSaveGameToSlot(SaveGame, SlotName, 0,
+            FAsyncSaveGameToSlotDelegate::CreateUObject(this, &UBoomerangScoreSubsystem::OnSaveWritten));
+    }
+
+    // History ring is updated on a worker thread
+    HistoryPipe.Launch(TEXT("AppendSessionHistory"),
+        [Path = GetHistoryPath(), Bytes = MoveTemp(RecordBytes)]() mutable
+        {
+            AppendToHistoryFile(Path, MoveTemp(Bytes));
+        });
+}
+
+
+void UBoomerangScoreSubsystem::OnSaveWritten(const FString& InSlotName, const int32 UserIndex, bool bSuccess)
+{
+    if (!bSuccess)
+    {
+        UE_LOG(LogBoomerang, Error, TEXT("Failed to save high score to slot %s"), *InSlotName);
+    }
+}
+
+
+FString UBoomerangScoreSubsystem::GetHistoryPath() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("SessionHistory.bin");
+}
+
+
+void UBoomerangScoreSubsystem::AppendToHistoryFile(const FString& Path, TArray<uint8> RecordBytes)
+{
+    using namespace BoomerangHistory;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+    // Opened for read/write without truncating, the append flag only seeks to the end once and later seeks are
+    // honoured, so each session rewrites one slot and the header in place
+    TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*Path, true, true));
+    if (!Handle)
+    {
+        UE_LOG(LogBoomerang, Error, TEXT("Could not open session history %s"), *Path);
+        return;
+    }
+
+    FHeader Header;
+    if (Handle->Size() >= HeaderSize)
+    {
+        FHeader Existing;
+        Handle->Seek(0);
+        Handle->Read(reinterpret_cast<uint8*>(&Existing), HeaderSize);
+
+        // Start over if the layout changed, otherwise continue the ring
+        if (Existing.Magic == Magic && Existing.RecordSize == Header.RecordSize && Existing.Capacity == Header.Capacity)
+        {
+            Header.Head = Existing.Head % Header.Capacity;
+            Header.Count = FMath::Min<uint32>(Existing.Count, Header.Capacity);
+        }
+    }
+
+    Handle->Seek(HeaderSize + static_cast<int64>(Header.Head) * Header.RecordSize);
+    Handle->Write(RecordBytes.GetData(), FMath::Min<int32>(RecordBytes.Num(), Header.RecordSize));
+
+    Header.Head = (Header.Head + 1) % Header.Capacity;
+    Header.Count = FMath::Min<uint32>(Header.Count + 1, Header.Capacity);
+
+    Handle->Seek(0);
+    Handle->Write(reinterpret_cast<const uint8*>(&Header), HeaderSize);
+    Handle->Flush();
+}
@@ -0,0 +1,55 @@
+// BoomerangScoreSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Pipe.h"
+#include "BoomerangSaveGame.h"
+#include "BoomerangScoreSubsystem.generated.h"
+
+class USaveGame;
+
+// Keeps the high score and session history across restarts and quits.
+// All disk access happens off the game thread.
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangScoreSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Called by the GameManager when a session ends
+    void RecordSession(const FBoomerangSessionRecord& Record);
+
+    int32 GetHighScore() const { return HighScore; }
+    bool IsLoaded() const { return bLoaded; }
+
+    // Max sessions kept in the history file, oldest are overwritten
+    static constexpr int32 HistoryCapacity = 256;
+
+private:
+    void OnSaveLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedSave);
+    void OnSaveWritten(const FString& SlotName, const int32 UserIndex, bool bSuccess);
+
+    // Writes one record into the ring file and updates its header (runs on the history pipe)
+    static void AppendToHistoryFile(const FString& Path, TArray<uint8> RecordBytes);
+
+    FString GetHistoryPath() const;
+
+    UPROPERTY()
+    UBoomerangSaveGame* SaveGame = nullptr;
+
+    int32 HighScore = 0;
+    bool bLoaded = false;
+
+    // Session that ended before the initial load finished
+    TOptional<FBoomerangSessionRecord> PendingRecord;
+
+    // Serializes history writes so appends never interleave
+    UE::Tasks::FPipe HistoryPipe{ TEXT("BoomerangHistory") };
+
+    static const FString SlotName;
+};
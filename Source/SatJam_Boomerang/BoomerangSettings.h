@@ -0,0 +1,169 @@
+// BoomerangSettings.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "BoomerangSettings.generated.h"
+
+class UNiagaraSystem;
+class USoundBase;
+class UBoomerangDistanceField;
+class UBoomerangTrajectoryShape;
+
+// How the global spawn rate is split between spawners
+UENUM()
+enum class ESpawnQuotaMode : uint8
+{
+    // By each spawner's SpawnWeight
+    Weight,
+
+    // By SpawnWeight, scaled up for spawners near a player
+    WeightAndProximity,
+};
+
+// Project-wide gameplay tuning, shown under Project Settings > Game > Boomerang
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Boomerang"))
+class SATJAM_BOOMERANG_API UBoomerangSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    // Max grounded boomerangs simulating physics at once, the rest play the baked tumble
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "0"))
+    int32 MaxSimulatingBoomerangs = 8;
+
+    // Skip physics entirely and always play the baked tumble
+    UPROPERTY(config, EditAnywhere, Category = "Settling")
+    bool bAlwaysUseBakedTumble = false;
+
+    // Higher values put settling bodies to sleep sooner
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "1.0"))
+    float SettleSleepThresholdMultiplier = 4.f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "0.0"))
+    float SettleLinearDamping = 0.5f;
+
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "0.0"))
+    float SettleAngularDamping = 1.f;
+
+    // How long a grounded boomerang stays in the world
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "0.1"))
+    float SettleLifeSpan = 3.f;
+
+    // A simulating boomerang that hasn't gone to sleep by then stops simulating and frees its slot
+    UPROPERTY(config, EditAnywhere, Category = "Settling", meta = (ClampMin = "0.1"))
+    float SettleSleepTimeout = 1.5f;
+
+    // Find target hits and the first wall along the whole path when a boomerang is thrown and fire them on
+    // the flight timeline, instead of sweeping every frame. Targets spawned mid-flight are rescheduled.
+    UPROPERTY(config, EditAnywhere, Category = "Flight")
+    bool bScheduleFlightHits = true;
+
+    // Shapes throws can fly besides the built-in loop, loaded at startup, so changes need a restart.
+    // Order is the id sent with each throw, so only append while clients and servers of different builds may play together.
+    UPROPERTY(config, EditAnywhere, Category = "Flight", meta = (ConfigRestartRequired = true))
+    TArray<TSoftObjectPtr<UBoomerangTrajectoryShape>> TrajectoryShapes;
+
+    // Baked static collision per map, used by flight and preview sweeps. Maps without one sweep physics.
+    // Bake with -run=BakeDistanceField -map=<map>.
+    UPROPERTY(config, EditAnywhere, Category = "Flight")
+    TMap<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UBoomerangDistanceField>> ArenaDistanceFields;
+
+    // Effects and sounds for hit feedback, CPU-sim Niagara systems are expected
+    UPROPERTY(config, EditAnywhere, Category = "Feedback")
+    TSoftObjectPtr<UNiagaraSystem> TargetPopEffect;
+
+    UPROPERTY(config, EditAnywhere, Category = "Feedback")
+    TSoftObjectPtr<USoundBase> TargetPopSound;
+
+    UPROPERTY(config, EditAnywhere, Category = "Feedback")
+    TSoftObjectPtr<UNiagaraSystem> GroundImpactEffect;
+
+    UPROPERTY(config, EditAnywhere, Category = "Feedback")
+    TSoftObjectPtr<USoundBase> GroundImpactSound;
+
+    // Components created per event type at BeginPlay
+    UPROPERTY(config, EditAnywhere, Category = "Feedback", meta = (ClampMin = "1"))
+    int32 FeedbackPoolSize = 16;
+
+    // Feedback events played per frame, extra events are dropped
+    UPROPERTY(config, EditAnywhere, Category = "Feedback", meta = (ClampMin = "0"))
+    int32 FeedbackMaxSpawnsPerFrame = 4;
+
+    // Events further than this from the camera are skipped
+    UPROPERTY(config, EditAnywhere, Category = "Feedback", meta = (ClampMin = "0.0"))
+    float FeedbackCullDistance = 5000.f;
+
+    // Live targets across all spawners, 0 for no limit
+    UPROPERTY(config, EditAnywhere, Category = "Spawning", meta = (ClampMin = "0"))
+    int32 MaxLiveTargets = 64;
+
+    // Spawns per second across all spawners, 0 for no limit
+    UPROPERTY(config, EditAnywhere, Category = "Spawning", meta = (ClampMin = "0.0"))
+    float MaxSpawnsPerSecond = 10.f;
+
+    // Spawns per frame across all spawners, 0 for no limit
+    UPROPERTY(config, EditAnywhere, Category = "Spawning", meta = (ClampMin = "0"))
+    int32 MaxSpawnsPerFrame = 2;
+
+    UPROPERTY(config, EditAnywhere, Category = "Spawning")
+    ESpawnQuotaMode SpawnQuotaMode = ESpawnQuotaMode::Weight;
+
+    // Distance at which a spawner's proximity bonus halves
+    UPROPERTY(config, EditAnywhere, Category = "Spawning", meta = (ClampMin = "1.0", EditCondition = "SpawnQuotaMode == ESpawnQuotaMode::WeightAndProximity"))
+    float SpawnProximityFalloff = 1500.f;
+
+    // Score targets by distance and view angle, dropping LOD and overlaps on insignificant ones
+    UPROPERTY(config, EditAnywhere, Category = "Significance")
+    bool bEnableTargetSignificance = true;
+
+    // Targets at or beyond this distance from every view score lowest
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "1.0"))
+    float TargetSignificanceDistance = 3000.f;
+
+    // Targets outside this cone around the view direction count as off screen
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "1.0", ClampMax = "180.0", Units = "deg"))
+    float TargetViewHalfAngle = 60.f;
+
+    // Targets scoring below this use TargetLowDetailLOD
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float TargetHighDetailSignificance = 0.35f;
+
+    // Mesh LOD forced on low-significance targets
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+    int32 TargetLowDetailLOD = 1;
+
+    // Added to a thrower's reach when deciding a target can't be hit, covers target and boomerang size
+    UPROPERTY(config, EditAnywhere, Category = "Significance", meta = (ClampMin = "0.0"))
+    float TargetReachMargin = 100.f;
+
+    // Degrade preview fidelity, spawn rate and physics settling when the game thread is over budget
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget")
+    bool bEnableFrameBudgetGovernor = true;
+
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta = (ClampMin = "1.0", Units = "ms"))
+    float GameThreadBudgetMs = 10.f;
+
+    // Fraction of the budget the game thread must drop below before quality is restored
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta = (ClampMin = "0.1", ClampMax = "1.0"))
+    float GovernorRestoreFraction = 0.75f;
+
+    // Seconds between adjustments, so one spike doesn't flip quality back and forth
+    UPROPERTY(config, EditAnywhere, Category = "Frame Budget", meta = (ClampMin = "0.1", Units = "s"))
+    float GovernorAdjustInterval = 1.f;
+
+    // Heatmap grid cell size, grids are centered on the world origin
+    UPROPERTY(config, EditAnywhere, Category = "Analytics", meta = (ClampMin = "1.0"))
+    float HeatmapCellSize = 100.f;
+
+    // Cells along X and Y, covers CellsXY * CellSize units
+    UPROPERTY(config, EditAnywhere, Category = "Analytics", meta = (ClampMin = "1", ClampMax = "4096"))
+    int32 HeatmapCellsXY = 128;
+
+    // Height layers for target outcomes, from z = 0 up
+    UPROPERTY(config, EditAnywhere, Category = "Analytics", meta = (ClampMin = "1", ClampMax = "256"))
+    int32 HeatmapCellsZ = 8;
+
+    virtual FName GetCategoryName() const override { return TEXT("Game"); }
+};
@@ -0,0 +1,29 @@
+// BoomerangSettleSubsystem.cpp
+
+#include "BoomerangSettleSubsystem.h"
+#include "BoomerangActor.h"
+#include "BoomerangSettings.h"
+
+
+int32 UBoomerangSettleSubsystem::GetMaxSimulating() const
+{
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    if (Settings->bAlwaysUseBakedTumble) return 0;
+
+    return MaxSimulatingOverride != INDEX_NONE ? MaxSimulatingOverride : Settings->MaxSimulatingBoomerangs;
+}
+
+
+bool UBoomerangSettleSubsystem::TryBeginSimulating(ABoomerangActor* Boomerang)
+{
+    if (!Boomerang || Simulating.Num() >= GetMaxSimulating()) return false;
+
+    Simulating.Add(Boomerang);
+    return true;
+}
+
+
+void UBoomerangSettleSubsystem::EndSimulating(ABoomerangActor* Boomerang)
+{
+    Simulating.Remove(Boomerang);
+}
@@ -0,0 +1,32 @@
+// BoomerangSettleSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BoomerangSettleSubsystem.generated.h"
+
+class ABoomerangActor;
+
+// Hands out the limited number of physics-simulated settle slots for grounded boomerangs
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangSettleSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Returns true if the boomerang may simulate physics, it must call EndSimulating when done
+    bool TryBeginSimulating(ABoomerangActor* Boomerang);
+    void EndSimulating(ABoomerangActor* Boomerang);
+
+    int32 GetNumSimulating() const { return Simulating.Num(); }
+    int32 GetMaxSimulating() const;
+
+    // Runtime override of the project setting, INDEX_NONE restores it
+    void SetMaxSimulatingOverride(int32 NewMax) { MaxSimulatingOverride = NewMax; }
+
+private:
+    TSet<TObjectKey<ABoomerangActor>> Simulating;
+
+    int32 MaxSimulatingOverride = INDEX_NONE;
+};
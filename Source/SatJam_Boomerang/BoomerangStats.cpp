@@ -0,0 +1,37 @@
+// BoomerangStats.cpp
+
+#include "BoomerangStats.h"
+
+DEFINE_STAT(STAT_BoomerangTick);
+DEFINE_STAT(STAT_BoomerangOverlap);
+DEFINE_STAT(STAT_TargetOverlap);
+DEFINE_STAT(STAT_ThrowBoomerang);
+DEFINE_STAT(STAT_UpdateTrajectoryPreview);
+DEFINE_STAT(STAT_ComputeTrajectoryPreview);
+DEFINE_STAT(STAT_SpawnTarget);
+DEFINE_STAT(STAT_UpdateUI);
+DEFINE_STAT(STAT_BotPickAim);
+
+DEFINE_STAT(STAT_LiveBoomerangs);
+DEFINE_STAT(STAT_LiveTargets);
+
+DEFINE_STAT(STAT_UObjectsCreatedPerSecond);
+DEFINE_STAT(STAT_UObjectsDestroyedPerSecond);
+DEFINE_STAT(STAT_LastGCMs);
+DEFINE_STAT(STAT_GCHitches);
+
+DEFINE_STAT(STAT_BoomerangSweeps);
+DEFINE_STAT(STAT_SplineRebuilds);
+DEFINE_STAT(STAT_DistanceFieldSweeps);
+DEFINE_STAT(STAT_PhysicsFallbackSweeps);
+
+UE_TRACE_CHANNEL_DEFINE(BoomerangChannel);
+
+uint64 FBoomerangFrameCost::Cycles[(int32)EBoomerangFrameCost::Num] = {};
+int32 FBoomerangFrameCost::Calls[(int32)EBoomerangFrameCost::Num] = {};
+
+void FBoomerangFrameCost::Reset()
+{
+    FMemory::Memzero(Cycles);
+    FMemory::Memzero(Calls);
+}
@@ -0,0 +1,86 @@
+// BoomerangStats.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// "stat Boomerang" in game, named tracks in Insights
+DECLARE_STATS_GROUP(TEXT("Boomerang"), STATGROUP_Boomerang, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Boomerang Tick"), STAT_BoomerangTick, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Boomerang Overlap"), STAT_BoomerangOverlap, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Target Overlap"), STAT_TargetOverlap, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Throw Boomerang"), STAT_ThrowBoomerang, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Trajectory Preview"), STAT_UpdateTrajectoryPreview, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute Trajectory Preview"), STAT_ComputeTrajectoryPreview, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Target"), STAT_SpawnTarget, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update UI"), STAT_UpdateUI, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bot Pick Aim"), STAT_BotPickAim, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Boomerangs"), STAT_LiveBoomerangs, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Targets"), STAT_LiveTargets, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+
+// Set by FGCChurnMonitor when it is enabled
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("UObjects Created/s"), STAT_UObjectsCreatedPerSecond, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("UObjects Destroyed/s"), STAT_UObjectsDestroyedPerSecond, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last GC (ms)"), STAT_LastGCMs, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("GC Hitches"), STAT_GCHitches, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+
+// Reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sweeps"), STAT_BoomerangSweeps, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Spline Rebuilds"), STAT_SplineRebuilds, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Distance Field Sweeps"), STAT_DistanceFieldSweeps, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics Fallback Sweeps"), STAT_PhysicsFallbackSweeps, STATGROUP_Boomerang, SATJAM_BOOMERANG_API);
+
+// Off by default, enable at runtime with "Trace.Enable Boomerang" or -trace=default,Boomerang
+UE_TRACE_CHANNEL_EXTERN(BoomerangChannel, SATJAM_BOOMERANG_API);
+
+// Game-thread time per frame in the hot paths the stress benchmarks compare, read and reset by the soak test.
+// Sweep includes the overlap handlers the sweep triggers.
+enum class EBoomerangFrameCost : uint8
+{
+    Sweep,
+    Overlap,
+    Num
+};
+
+struct SATJAM_BOOMERANG_API FBoomerangFrameCost
+{
+    static uint64 Cycles[(int32)EBoomerangFrameCost::Num];
+    static int32 Calls[(int32)EBoomerangFrameCost::Num];
+
+    static float GetMs(EBoomerangFrameCost Cost) { return static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles[(int32)Cost])); }
+    static void Reset();
+};
+
+struct FBoomerangFrameCostScope
+{
+    explicit FBoomerangFrameCostScope(EBoomerangFrameCost InCost)
+        : Cost(InCost)
+        , StartCycles(FPlatformTime::Cycles64())
+    {
+    }
+
+    ~FBoomerangFrameCostScope()
+    {
+        FBoomerangFrameCost::Cycles[(int32)Cost] += FPlatformTime::Cycles64() - StartCycles;
+        FBoomerangFrameCost::Calls[(int32)Cost]++;
+    }
+
+    EBoomerangFrameCost Cost;
+    uint64 StartCycles;
+};
+
+#if UE_BUILD_SHIPPING
+#define BOOMERANG_SCOPE_FRAME_COST(Cost)
+#else
+#define BOOMERANG_SCOPE_FRAME_COST(Cost) FBoomerangFrameCostScope ANONYMOUS_VARIABLE(BoomerangFrameCost)(EBoomerangFrameCost::Cost)
+#endif
+
+// Stat cycle counter plus a CPU scope on the Boomerang trace channel
+#define BOOMERANG_SCOPE_CYCLE_COUNTER(Stat) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, BoomerangChannel); \
+    SCOPE_CYCLE_COUNTER(Stat)
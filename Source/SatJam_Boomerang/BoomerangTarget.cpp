@@ -1,8 +1,17 @@
 // BoomerangTarget.cpp
 
 #include "BoomerangTarget.h"
+#include "BoomerangStats.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangTelemetry.h"
+#include "BoomerangHeatmapSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "BoomerangActor.h"
+#include "TargetSpawner.h"
+#include "SpawnDirectorSubsystem.h"
+#include "HitFeedbackSubsystem.h"
+#include "TargetSignificanceSubsystem.h"
+#include "BoomerangSettings.h"
 #include "Kismet/GameplayStatics.h"
 
 
@@ -33,8 +42,71 @@ void ABoomerangTarget::BeginPlay()
 {
     Super::BeginPlay();
 
+    INC_DWORD_STAT(STAT_LiveTargets);
+
 	// Set timer to destroy target after lifeTime seconds
 	SetLifeSpan(lifeTime);
+
+    if (UTargetSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTargetSignificanceSubsystem>())
+    {
+        Significance->RegisterTarget(this);
+    }
+}
+
+
+void ABoomerangTarget::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    DEC_DWORD_STAT(STAT_LiveTargets);
+
+    if (UTargetSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTargetSignificanceSubsystem>())
+    {
+        Significance->UnregisterTarget(this);
+    }
+
+    if (Spawner)
+    {
+        if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+        {
+            Director->NotifyTargetRemoved(Spawner);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+
+// Timed out without being hit
+void ABoomerangTarget::LifeSpanExpired()
+{
+    FBoomerangTelemetry::Record(EBoomerangEvent::Expire, GetActorLocation(), GetUniqueID());
+
+    if (UBoomerangHeatmapSubsystem* Heatmap = GetWorld()->GetSubsystem<UBoomerangHeatmapSubsystem>())
+    {
+        Heatmap->RecordTarget(GetActorLocation(), false);
+    }
+
+    Super::LifeSpanExpired();
+}
+
+
+void ABoomerangTarget::InitializeSpawnSlot(ATargetSpawner* InSpawner, int32 InSlot)
+{
+    Spawner = InSpawner;
+    SpawnSlot = InSlot;
+}
+
+
+float ABoomerangTarget::GetHitRadius() const
+{
+    return TargetMesh->Bounds.SphereRadius;
+}
+
+
+bool ABoomerangTarget::IsTouchedBySweep(const FVector& Start, const FVector& End, float Radius) const
+{
+    // Only this mesh's body, the bounding sphere is too loose for flat or long meshes
+    FHitResult Hit;
+    return TargetMesh->SweepComponent(Hit, Start, End, FQuat::Identity, FCollisionShape::MakeSphere(Radius));
 }
 
 
@@ -54,11 +126,54 @@ UFUNCTION()
 void ABoomerangTarget::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_TargetOverlap);
+    BOOMERANG_SCOPE_FRAME_COST(Overlap);
+
     if (OtherActor && OtherActor->IsA(ABoomerangActor::StaticClass()))
     {
-        UE_LOG(LogTemp, Log, TEXT("Target overlapped by boomerang: %s"), *GetName());
+        UE_LOG(LogBoomerang, Log, TEXT("Target overlapped by boomerang: %s"), *GetName());
 
-        Destroy();
+        HandleHit();
     }
 }
 
+
+void ABoomerangTarget::HandleHit()
+{
+    // Both the target and the boomerang react to the same overlap
+    if (IsActorBeingDestroyed()) return;
+
+    // Server tells clients to remove their local copy
+    if (GetNetMode() != NM_Client && Spawner)
+    {
+        Spawner->NotifyTargetHit(SpawnSlot);
+    }
+
+    if (UHitFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<UHitFeedbackSubsystem>())
+    {
+        Feedback->Play(EHitFeedback::TargetPop, GetActorLocation());
+    }
+
+    Destroy();
+}
+
+
+void ABoomerangTarget::ApplySignificance(float Significance)
+{
+    const bool bNewReachable = Significance > 0.f;
+    const bool bNewHighDetail = Significance >= GetDefault<UBoomerangSettings>()->TargetHighDetailSignificance;
+
+    if (bNewReachable != bReachable)
+    {
+        bReachable = bNewReachable;
+        TargetMesh->SetGenerateOverlapEvents(bReachable);
+    }
+
+    if (bNewHighDetail != bHighDetail)
+    {
+        bHighDetail = bNewHighDetail;
+
+        // ForcedLodModel is 1-based, 0 lets the engine pick
+        TargetMesh->SetForcedLodModel(bHighDetail ? 0 : GetDefault<UBoomerangSettings>()->TargetLowDetailLOD + 1);
+    }
+}
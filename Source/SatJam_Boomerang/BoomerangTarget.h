@@ -6,6 +6,8 @@
 #include "GameFramework/Actor.h"
 #include "BoomerangTarget.generated.h"
 
+class ATargetSpawner;
+
 UCLASS()
 class SATJAM_BOOMERANG_API ABoomerangTarget : public AActor
 {
@@ -14,8 +16,28 @@ class SATJAM_BOOMERANG_API ABoomerangTarget : public AActor
 public:
     ABoomerangTarget();
 
+    // Set by the spawner so hits can be forwarded to clients by slot
+    void InitializeSpawnSlot(ATargetSpawner* InSpawner, int32 InSlot);
+
+    int32 GetSpawnSlot() const { return SpawnSlot; }
+
+    // Pops the target: notifies clients, plays feedback and destroys it. Safe to call more than once.
+    void HandleHit();
+
+    // Called by the significance manager. 0 means no thrower can reach the target, so overlaps
+    // are turned off; low scores use the cheaper mesh LOD.
+    void ApplySignificance(float Significance);
+
+    // Bounding sphere radius of the mesh, used to schedule hits ahead of time
+    float GetHitRadius() const;
+
+    // Whether a sphere moved from Start to End touches the target's collision
+    bool IsTouchedBySweep(const FVector& Start, const FVector& End, float Radius) const;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void LifeSpanExpired() override;
 
 private:
     // Static mesh for visual representation
@@ -25,6 +47,16 @@ private:
     UPROPERTY(EditAnywhere, Category = "Target")
     float lifeTime = 5.0f;
 
+    // Spawner and slot this target was created from
+    UPROPERTY()
+    ATargetSpawner* Spawner = nullptr;
+
+    int32 SpawnSlot = INDEX_NONE;
+
+    // Current significance state, so components are only touched on changes
+    bool bHighDetail = true;
+    bool bReachable = true;
+
     // Handles hit events
     UFUNCTION()
     void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor,
@@ -0,0 +1,330 @@
+// BoomerangTelemetry.cpp
+
+#include "BoomerangTelemetry.h"
+#include "SatJam_Boomerang.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+#if PLATFORM_UNIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace BoomerangTelemetry
+{
+    // Power of two so indices wrap with a mask
+    constexpr uint32 RingCapacity = 4096;
+
+    // Header at the start of every output stream
+    struct FStreamHeader
+    {
+        uint32 Magic = 0x4D4C5442;  // "BTLM"
+        uint16 Version = 1;
+        uint16 RecordSize = sizeof(FBoomerangEventRecord);
+        double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+    };
+
+    // Single producer (the owning thread), single consumer (the flusher)
+    struct FThreadRing
+    {
+        FBoomerangEventRecord Records[RingCapacity];
+        std::atomic<uint32> Head{ 0 };  // written by the producer
+        std::atomic<uint32> Tail{ 0 };  // written by the consumer
+        std::atomic<uint32> Dropped{ 0 };
+    };
+
+    // Only set while a flusher exists to drain the rings
+    static std::atomic<bool> bEnabled{ false };
+
+    // Rings are only added (once per thread) and freed at shutdown
+    static FCriticalSection RingsLock;
+    static TArray<FThreadRing*> Rings;
+
+    // Bumped by Shutdown, a thread's cached ring from an older generation has been freed
+    static std::atomic<uint32> RingGeneration{ 1 };
+
+    static thread_local FThreadRing* LocalRing = nullptr;
+    static thread_local uint32 LocalRingGeneration = 0;
+
+    static FThreadRing* GetLocalRing()
+    {
+        const uint32 Generation = RingGeneration.load(std::memory_order_acquire);
+        if (!LocalRing || LocalRingGeneration != Generation)
+        {
+            LocalRing = new FThreadRing();
+            LocalRingGeneration = Generation;
+            FScopeLock Lock(&RingsLock);
+            Rings.Add(LocalRing);
+        }
+        return LocalRing;
+    }
+
+
+    // Drains every ring to the output on a background thread
+    class FFlusher : public FRunnable
+    {
+    public:
+        FFlusher(const FString& InFilePath, const FString& InSocketPath)
+            : FilePath(InFilePath)
+            , SocketPath(InSocketPath)
+        {
+            Thread = FRunnableThread::Create(this, TEXT("BoomerangTelemetryFlusher"), 0, TPri_BelowNormal);
+        }
+
+        virtual ~FFlusher() override
+        {
+            if (Thread)
+            {
+                Thread->Kill(true);
+                delete Thread;
+            }
+        }
+
+        virtual bool Init() override
+        {
+            return OpenOutput();
+        }
+
+        virtual uint32 Run() override
+        {
+            while (!bStopping.load())
+            {
+                FPlatformProcess::Sleep(0.1f);
+                Flush();
+            }
+
+            Flush();
+            return 0;
+        }
+
+        virtual void Stop() override
+        {
+            bStopping.store(true);
+        }
+
+        virtual void Exit() override
+        {
+            FileHandle.Reset();
+#if PLATFORM_UNIX
+            if (Socket >= 0)
+            {
+                close(Socket);
+                Socket = -1;
+            }
+#endif
+        }
+
+    private:
+        bool OpenOutput()
+        {
+            const FStreamHeader Header;
+
+#if PLATFORM_UNIX
+            if (!SocketPath.IsEmpty())
+            {
+                Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+                sockaddr_un Address = {};
+                Address.sun_family = AF_UNIX;
+                FCStringAnsi::Strncpy(Address.sun_path, TCHAR_TO_UTF8(*SocketPath), sizeof(Address.sun_path));
+
+                if (Socket < 0 || connect(Socket, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0)
+                {
+                    UE_LOG(LogBoomerang, Error, TEXT("Telemetry could not connect to socket %s"), *SocketPath);
+                    return false;
+                }
+
+                return Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+            }
+#endif
+
+            IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+            PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+            FileHandle.Reset(PlatformFile.OpenWrite(*FilePath));
+
+            if (!FileHandle)
+            {
+                UE_LOG(LogBoomerang, Error, TEXT("Telemetry could not open %s"), *FilePath);
+                return false;
+            }
+
+            return Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+        }
+
+        bool Write(const uint8* Data, int64 Size)
+        {
+#if PLATFORM_UNIX
+            if (Socket >= 0)
+            {
+                while (Size > 0)
+                {
+                    const ssize_t Sent = send(Socket, Data, Size, MSG_NOSIGNAL);
+                    if (Sent <= 0) return false;
+                    Data += Sent;
+                    Size -= Sent;
+                }
+                return true;
+            }
+#endif
+            return FileHandle && FileHandle->Write(Data, Size);
+        }
+
+        void Flush()
+        {
+            TArray<FThreadRing*> RingsCopy;
+            {
+                FScopeLock Lock(&RingsLock);
+                RingsCopy = Rings;
+            }
+
+            for (FThreadRing* Ring : RingsCopy)
+            {
+                const uint32 Tail = Ring->Tail.load(std::memory_order_relaxed);
+                const uint32 Head = Ring->Head.load(std::memory_order_acquire);
+                if (Head == Tail) continue;
+
+                // At most two contiguous runs because of wrap-around
+                const uint32 First = Tail & (RingCapacity - 1);
+                const uint32 Count = Head - Tail;
+                const uint32 FirstRun = FMath::Min(Count, RingCapacity - First);
+
+                Write(reinterpret_cast<const uint8*>(&Ring->Records[First]), FirstRun * sizeof(FBoomerangEventRecord));
+                if (Count > FirstRun)
+                {
+                    Write(reinterpret_cast<const uint8*>(&Ring->Records[0]), (Count - FirstRun) * sizeof(FBoomerangEventRecord));
+                }
+
+                Ring->Tail.store(Head, std::memory_order_release);
+
+                if (const uint32 Dropped = Ring->Dropped.exchange(0))
+                {
+                    UE_LOG(LogBoomerang, Warning, TEXT("Telemetry dropped %u events, ring was full"), Dropped);
+                }
+            }
+
+            if (FileHandle)
+            {
+                FileHandle->Flush();
+            }
+        }
+
+        FString FilePath;
+        FString SocketPath;
+        TUniquePtr<IFileHandle> FileHandle;
+#if PLATFORM_UNIX
+        int Socket = -1;
+#endif
+        std::atomic<bool> bStopping{ false };
+        FRunnableThread* Thread = nullptr;
+    };
+
+    static FFlusher* Flusher = nullptr;
+
+    // Set between Startup and Shutdown, the flusher is only created inside that window
+    static bool bStartedUp = false;
+    static FString SocketPath;
+
+    // Creates the flusher the first time telemetry is turned on, so sessions without telemetry
+    // get no thread and no empty event file. Game thread only.
+    static void ApplyEnabled(bool bWantEnabled)
+    {
+        if (bWantEnabled && bStartedUp && !Flusher)
+        {
+            const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Telemetry") /
+                FString::Printf(TEXT("Events_%s.bin"), *FDateTime::Now().ToString());
+
+            // Stays up once created so the cvar can be toggled at any time
+            Flusher = new FFlusher(FilePath, SocketPath);
+        }
+
+        bEnabled.store(bWantEnabled && Flusher != nullptr, std::memory_order_release);
+    }
+
+    static TAutoConsoleVariable<int32> CVarTelemetry(
+        TEXT("boomerang.Telemetry"),
+        0,
+        TEXT("Record gameplay events to the telemetry ring buffer (0 = off, 1 = on)."),
+        FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Var)
+        {
+            ApplyEnabled(Var->GetInt() != 0);
+        }));
+}
+
+
+void FBoomerangTelemetry::Startup()
+{
+    using namespace BoomerangTelemetry;
+
+    bStartedUp = true;
+    SocketPath.Reset();
+    FParse::Value(FCommandLine::Get(), TEXT("boomerangtelemetrysocket="), SocketPath);
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("boomerangtelemetry")) || !SocketPath.IsEmpty())
+    {
+        CVarTelemetry->Set(1, ECVF_SetByCommandline);
+    }
+
+    // The cvar may have been turned on by config before startup
+    ApplyEnabled(CVarTelemetry.GetValueOnGameThread() != 0);
+}
+
+
+void FBoomerangTelemetry::Shutdown()
+{
+    using namespace BoomerangTelemetry;
+
+    bStartedUp = false;
+    bEnabled.store(false);
+
+    delete Flusher;
+    Flusher = nullptr;
+
+    FScopeLock Lock(&RingsLock);
+    for (FThreadRing* Ring : Rings)
+    {
+        delete Ring;
+    }
+    Rings.Empty();
+
+    // Threads still pointing at the freed rings allocate new ones on their next event
+    RingGeneration.fetch_add(1, std::memory_order_release);
+}
+
+
+bool FBoomerangTelemetry::IsEnabled()
+{
+    return BoomerangTelemetry::bEnabled.load(std::memory_order_acquire);
+}
+
+
+void FBoomerangTelemetry::Record(EBoomerangEvent Type, const FVector& Location, uint32 ActorId)
+{
+    using namespace BoomerangTelemetry;
+
+    if (!IsEnabled()) return;
+
+    FThreadRing* Ring = GetLocalRing();
+    const uint32 Head = Ring->Head.load(std::memory_order_relaxed);
+    const uint32 Tail = Ring->Tail.load(std::memory_order_acquire);
+
+    if (Head - Tail >= RingCapacity)
+    {
+        Ring->Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    FBoomerangEventRecord& Record = Ring->Records[Head & (RingCapacity - 1)];
+    Record.Cycles = FPlatformTime::Cycles64();
+    Record.Location = FVector3f(Location);
+    Record.ActorId = ActorId;
+    Record.Type = Type;
+
+    Ring->Head.store(Head + 1, std::memory_order_release);
+}
@@ -0,0 +1,42 @@
+// BoomerangTelemetry.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Gameplay events kept for offline analysis
+enum class EBoomerangEvent : uint8
+{
+    Spawn,          // target spawned
+    Throw,          // boomerang thrown
+    Hit,            // target hit by a boomerang
+    GroundImpact,   // boomerang hit world static geometry
+    Expire,         // target timed out unhit
+};
+
+// Fixed-size binary event, written to disk as is
+struct FBoomerangEventRecord
+{
+    uint64 Cycles = 0;      // FPlatformTime::Cycles64 when recorded
+    FVector3f Location = FVector3f::ZeroVector;
+    uint32 ActorId = 0;     // UObject unique id
+    EBoomerangEvent Type = EBoomerangEvent::Spawn;
+    uint8 Padding[3] = {};
+};
+static_assert(sizeof(FBoomerangEventRecord) == 32, "Telemetry records are expected to be 32 bytes");
+
+
+// Records events into per-thread lock-free rings that a background thread drains
+// to Saved/Telemetry (or a Unix socket with -boomerangtelemetrysocket=<path>).
+// Enable with -boomerangtelemetry or boomerang.Telemetry 1.
+class SATJAM_BOOMERANG_API FBoomerangTelemetry
+{
+public:
+    static void Startup();
+    static void Shutdown();
+
+    static bool IsEnabled();
+
+    // Cheap enough for every gameplay event, drops the event when the thread's ring is full
+    static void Record(EBoomerangEvent Type, const FVector& Location, uint32 ActorId);
+};
@@ -0,0 +1,108 @@
+// BoomerangThrowDescriptor.cpp
+
+#include "BoomerangThrowDescriptor.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangTrajectory.h"
+#include "BoomerangTrajectoryLibrary.h"
+#include "UObject/CoreNet.h"
+#include "HAL/IConsoleManager.h"
+
+
+FBoomerangThrowDescriptor FBoomerangThrowDescriptor::Make(const FVector& InStart, const FRotator& InAim,
+    float InDistance, float InCurveRadius, float InFlightTime, int32 InNumSegments, uint8 InShape)
+{
+    FBoomerangThrowDescriptor Descriptor;
+    Descriptor.Start = InStart.RoundToVector();
+    Descriptor.Yaw = FRotator::CompressAxisToShort(InAim.Yaw);
+    Descriptor.Pitch = FRotator::CompressAxisToShort(InAim.Pitch);
+    Descriptor.Distance = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(InDistance), 0, MAX_uint16));
+    Descriptor.CurveRadius = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(InCurveRadius), 0, MAX_uint16));
+    Descriptor.FlightTimeMs = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(InFlightTime * 1000.f), 1, MAX_uint16));
+    Descriptor.NumSegments = static_cast<uint8>(FMath::Clamp(InNumSegments, 1, MAX_uint8));
+    Descriptor.Shape = InShape;
+    return Descriptor;
+}
+
+
+FRotator FBoomerangThrowDescriptor::GetAim() const
+{
+    return FRotator(
+        FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(Pitch)),
+        FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(Yaw)),
+        0.f);
+}
+
+
+void FBoomerangThrowDescriptor::BuildPath(TArray<FVector>& OutPoints) const
+{
+    // Shapes are tables baked at cook time, the same cost as the built-in loop
+    BoomerangMath::BuildPath(Start, GetAim(), Distance, CurveRadius, NumSegments, UBoomerangTrajectoryLibrary::GetTable(Shape), OutPoints);
+}
+
+
+float FBoomerangThrowDescriptor::GetMaxRadius() const
+{
+    return BoomerangMath::GetMaxRadius(Distance, CurveRadius, NumSegments, UBoomerangTrajectoryLibrary::GetTable(Shape));
+}
+
+
+bool FBoomerangThrowDescriptor::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Start.NetSerialize(Ar, Map, bOutSuccess);
+
+    Ar << Yaw;
+    Ar << Pitch;
+    Ar << Distance;
+    Ar << CurveRadius;
+    Ar << FlightTimeMs;
+    Ar << NumSegments;
+    Ar << Shape;
+
+    bOutSuccess = bOutSuccess && !Ar.IsError();
+    return true;
+}
+
+
+namespace BoomerangNetStats
+{
+    static int64 NumThrows = 0;
+    static int64 TotalBits = 0;
+    static int64 MinBits = MAX_int64;
+    static int64 MaxBits = 0;
+}
+
+
+void FBoomerangNetStats::RecordThrow(const FBoomerangThrowDescriptor& Descriptor)
+{
+    using namespace BoomerangNetStats;
+
+    // Serialize into a scratch writer to measure the payload size
+    FNetBitWriter Writer(nullptr, 256);
+    bool bSuccess = true;
+    const_cast<FBoomerangThrowDescriptor&>(Descriptor).NetSerialize(Writer, nullptr, bSuccess);
+
+    const int64 Bits = Writer.GetNumBits();
+    NumThrows++;
+    TotalBits += Bits;
+    MinBits = FMath::Min(MinBits, Bits);
+    MaxBits = FMath::Max(MaxBits, Bits);
+}
+
+
+static FAutoConsoleCommand NetThrowReportCommand(
+    TEXT("boomerang.NetThrowReport"),
+    TEXT("Logs the replicated payload size of boomerang throws."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        using namespace BoomerangNetStats;
+
+        if (NumThrows == 0)
+        {
+            UE_LOG(LogBoomerang, Display, TEXT("No replicated throws yet."));
+            return;
+        }
+
+        const double AvgBits = static_cast<double>(TotalBits) / NumThrows;
+        UE_LOG(LogBoomerang, Display, TEXT("Replicated throws: %lld, payload per throw avg %.1f bits (%.1f bytes), min %lld, max %lld bits. RPC and packet headers not included."),
+            NumThrows, AvgBits, AvgBits / 8.0, MinBits, MaxBits);
+    }));
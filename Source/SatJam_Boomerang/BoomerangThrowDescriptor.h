@@ -0,0 +1,82 @@
+// BoomerangThrowDescriptor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "BoomerangThrowDescriptor.generated.h"
+
+// Everything needed to rebuild a throw's flight path.
+// Sent once per throw instead of replicating the boomerang's transform every frame.
+USTRUCT()
+struct SATJAM_BOOMERANG_API FBoomerangThrowDescriptor
+{
+    GENERATED_BODY()
+
+    // Throw origin, rounded to whole units
+    UPROPERTY()
+    FVector_NetQuantize Start = FVector::ZeroVector;
+
+    // Aim, compressed with FRotator::CompressAxisToShort
+    UPROPERTY()
+    uint16 Yaw = 0;
+
+    UPROPERTY()
+    uint16 Pitch = 0;
+
+    // Path shape in whole units
+    UPROPERTY()
+    uint16 Distance = 0;
+
+    UPROPERTY()
+    uint16 CurveRadius = 0;
+
+    // Total flight time in milliseconds
+    UPROPERTY()
+    uint16 FlightTimeMs = 0;
+
+    // Number of straight segments in the path
+    UPROPERTY()
+    uint8 NumSegments = 0;
+
+    // Trajectory shape id from UBoomerangTrajectoryLibrary, 0 is the built-in loop
+    UPROPERTY()
+    uint8 Shape = 0;
+
+    // Build a descriptor, quantizing the inputs the same way they are sent
+    static FBoomerangThrowDescriptor Make(const FVector& InStart, const FRotator& InAim,
+        float InDistance, float InCurveRadius, float InFlightTime, int32 InNumSegments, uint8 InShape = 0);
+
+    FRotator GetAim() const;
+    float GetFlightTime() const { return FlightTimeMs / 1000.f; }
+
+    // Sample the path, identical on server and clients since only quantized values are used
+    void BuildPath(TArray<FVector>& OutPoints) const;
+
+    // Furthest the path gets from Start, for any aim
+    float GetMaxRadius() const;
+
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool operator==(const FBoomerangThrowDescriptor& Other) const
+    {
+        return Start == Other.Start && Yaw == Other.Yaw && Pitch == Other.Pitch && Distance == Other.Distance
+            && CurveRadius == Other.CurveRadius && FlightTimeMs == Other.FlightTimeMs && NumSegments == Other.NumSegments && Shape == Other.Shape;
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FBoomerangThrowDescriptor> : public TStructOpsTypeTraitsBase2<FBoomerangThrowDescriptor>
+{
+    enum
+    {
+        WithNetSerializer = true,
+    };
+};
+
+
+// Running totals for the bandwidth-per-throw report (boomerang.NetThrowReport)
+struct FBoomerangNetStats
+{
+    static void RecordThrow(const FBoomerangThrowDescriptor& Descriptor);
+};
@@ -0,0 +1,67 @@
+// BoomerangTrajectoryLibrary.cpp
+
+#include "BoomerangTrajectoryLibrary.h"
+#include "BoomerangTrajectoryShape.h"
+#include "BoomerangSettings.h"
+#include "SatJam_Boomerang.h"
+#include "Engine/Engine.h"
+
+
+void UBoomerangTrajectoryLibrary::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const TArray<TSoftObjectPtr<UBoomerangTrajectoryShape>>& Registered = GetDefault<UBoomerangSettings>()->TrajectoryShapes;
+
+    // Ids are one byte and 0 is taken by the built-in loop
+    for (int32 i = 0; i < FMath::Min(Registered.Num(), static_cast<int32>(MAX_uint8)); ++i)
+    {
+        UBoomerangTrajectoryShape* Shape = Registered[i].LoadSynchronous();
+        if (!Shape || Shape->GetTable().Num() < 2)
+        {
+            UE_LOG(LogBoomerang, Warning, TEXT("Trajectory shape %s is missing or not baked, throws with it fly the built-in loop"), *Registered[i].ToString());
+        }
+
+        // Kept even when unusable so the ids of the following shapes don't shift
+        Shapes.Add(Shape);
+    }
+}
+
+
+TConstArrayView<FVector3f> UBoomerangTrajectoryLibrary::GetTable(uint8 ShapeId)
+{
+    const UBoomerangTrajectoryLibrary* Library = ShapeId != 0 && GEngine ? GEngine->GetEngineSubsystem<UBoomerangTrajectoryLibrary>() : nullptr;
+    if (!Library || !Library->Shapes.IsValidIndex(ShapeId - 1)) return {};
+
+    const UBoomerangTrajectoryShape* Shape = Library->Shapes[ShapeId - 1];
+    return Shape ? Shape->GetTable() : TConstArrayView<FVector3f>();
+}
+
+
+uint8 UBoomerangTrajectoryLibrary::GetShapeId(const UBoomerangTrajectoryShape* Shape)
+{
+    const UBoomerangTrajectoryLibrary* Library = Shape && GEngine ? GEngine->GetEngineSubsystem<UBoomerangTrajectoryLibrary>() : nullptr;
+    if (!Library) return 0;
+
+    const int32 Index = Library->Shapes.IndexOfByKey(Shape);
+    if (Index == INDEX_NONE)
+    {
+        // Once per shape, a designer's unregistered shape would otherwise warn on every throw
+        static TSet<FSoftObjectPath> Warned;
+        static FCriticalSection WarnedLock;
+
+        bool bAlreadyWarned;
+        {
+            FScopeLock Lock(&WarnedLock);
+            Warned.Add(FSoftObjectPath(Shape), &bAlreadyWarned);
+        }
+
+        if (!bAlreadyWarned)
+        {
+            UE_LOG(LogBoomerang, Warning, TEXT("Trajectory shape %s is not in the project's TrajectoryShapes, throwing the built-in loop. Add it and restart."), *Shape->GetPathName());
+        }
+        return 0;
+    }
+
+    return static_cast<uint8>(Index + 1);
+}
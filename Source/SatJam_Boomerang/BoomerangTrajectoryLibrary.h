@@ -0,0 +1,31 @@
+// BoomerangTrajectoryLibrary.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "BoomerangTrajectoryLibrary.generated.h"
+
+class UBoomerangTrajectoryShape;
+
+// Loads the shapes in UBoomerangSettings::TrajectoryShapes once at startup and keeps them for the whole run.
+// Throw descriptors carry a shape id: 0 is the built-in loop, N the Nth registered shape.
+UCLASS()
+class SATJAM_BOOMERANG_API UBoomerangTrajectoryLibrary : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // Baked table for a shape id, empty for the built-in loop or an unknown id. Safe from any thread.
+    static TConstArrayView<FVector3f> GetTable(uint8 ShapeId);
+
+    // Id to send for a shape, 0 if it isn't registered
+    static uint8 GetShapeId(const UBoomerangTrajectoryShape* Shape);
+
+private:
+    // Never changes after Initialize, which is what makes the lookups thread-safe
+    UPROPERTY()
+    TArray<TObjectPtr<UBoomerangTrajectoryShape>> Shapes;
+};
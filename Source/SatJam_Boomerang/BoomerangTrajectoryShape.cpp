@@ -0,0 +1,52 @@
+// BoomerangTrajectoryShape.cpp
+
+#include "BoomerangTrajectoryShape.h"
+#include "BoomerangTrajectory.h"
+#include "Curves/CurveVector.h"
+#include "UObject/ObjectSaveContext.h"
+
+#if WITH_EDITOR
+
+void UBoomerangTrajectoryShape::PreSave(FObjectPreSaveContext SaveContext)
+{
+    // Cooked builds never evaluate the curve, only the table saved here
+    BakeTable();
+
+    Super::PreSave(SaveContext);
+}
+
+
+void UBoomerangTrajectoryShape::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // So PIE flies the edited shape before it is saved
+    BakeTable();
+}
+
+
+void UBoomerangTrajectoryShape::BakeTable()
+{
+    if (!Curve)
+    {
+        Table.Reset();
+        return;
+    }
+
+    float MinTime = 0.f;
+    float MaxTime = 1.f;
+    Curve->GetTimeRange(MinTime, MaxTime);
+    if (MaxTime <= MinTime)
+    {
+        MaxTime = MinTime + 1.f;
+    }
+
+    const UCurveVector* Source = Curve;
+    BoomerangMath::BakeShapeTable([Source, MinTime, MaxTime](float T)
+        {
+            return FVector3f(Source->GetVectorValue(FMath::Lerp(MinTime, MaxTime, T)));
+        },
+        DesignCurveRatio, BoomerangMath::ShapeTableSize, Table);
+}
+
+#endif
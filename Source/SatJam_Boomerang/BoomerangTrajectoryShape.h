@@ -0,0 +1,43 @@
+// BoomerangTrajectoryShape.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "BoomerangTrajectoryShape.generated.h"
+
+class UCurveVector;
+
+// Flight path shape authored as a vector curve over time 0 to 1 in the throw's frame:
+// X forward in units of Distance, Y right and Z up in units of CurveRadius. It should start and end at 0 so the boomerang comes back.
+// The curve is editor-only, saving (and so cooking) bakes it into an arc-length normalized table the flight and preview sample.
+// Register shapes in UBoomerangSettings::TrajectoryShapes so throws can reference them.
+UCLASS(BlueprintType)
+class SATJAM_BOOMERANG_API UBoomerangTrajectoryShape : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+    UPROPERTY(EditAnywhere, Category = "Shape")
+    TObjectPtr<UCurveVector> Curve;
+#endif
+
+    // CurveRadius / Distance the arc length is measured at, other ratios stretch the spacing slightly
+    UPROPERTY(EditAnywhere, Category = "Shape", meta = (ClampMin = "0.01"))
+    float DesignCurveRatio = 0.3f;
+
+    // BoomerangMath::ShapeTableSize points evenly spaced along the curve
+    UPROPERTY(VisibleAnywhere, Category = "Bake")
+    TArray<FVector3f> Table;
+
+    TConstArrayView<FVector3f> GetTable() const { return Table; }
+
+#if WITH_EDITOR
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+    // Rebuilds Table from Curve
+    void BakeTable();
+#endif
+};
@@ -0,0 +1,112 @@
+// FrameBudgetGovernor.cpp
+
+#include "FrameBudgetGovernor.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangSettings.h"
+#include "BoomerangSettleSubsystem.h"
+#include "SpawnDirectorSubsystem.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "CoreGlobals.h"
+
+CSV_DEFINE_CATEGORY(BoomerangGovernor, true);
+
+namespace BoomerangGovernor
+{
+    // Quality per level, index 0 is full quality
+    constexpr float PreviewPointScale[] = { 1.f, 0.75f, 0.5f, 0.25f };
+    constexpr float SpawnRateScale[] = { 1.f, 0.75f, 0.5f, 0.33f };
+    constexpr int32 SettleCap[] = { INDEX_NONE, 4, 2, 0 };   // INDEX_NONE keeps the project setting
+
+    constexpr int32 MaxLevel = UE_ARRAY_COUNT(PreviewPointScale) - 1;
+}
+
+
+bool UFrameBudgetGovernor::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UFrameBudgetGovernor::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UFrameBudgetGovernor::OnEndFrame);
+}
+
+
+void UFrameBudgetGovernor::Deinitialize()
+{
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+    Super::Deinitialize();
+}
+
+
+void UFrameBudgetGovernor::OnEndFrame()
+{
+    // Last frame's game-thread work without the vsync and frame-rate limiter waits, a capped idle frame is far under budget
+    Budget.AddFrameSample(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+}
+
+
+void UFrameBudgetGovernor::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    if (!Settings->bEnableFrameBudgetGovernor)
+    {
+        SetLevel(0);
+        return;
+    }
+
+    CSV_CUSTOM_STAT(BoomerangGovernor, Level, Level, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangGovernor, AverageGameThreadMs, Budget.GetAverageMs(), ECsvCustomStatOp::Set);
+
+    SetLevel(Budget.Update(DeltaTime, Settings->GameThreadBudgetMs, Settings->GovernorRestoreFraction,
+        Settings->GovernorAdjustInterval, BoomerangGovernor::MaxLevel));
+}
+
+
+TStatId UFrameBudgetGovernor::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UFrameBudgetGovernor, STATGROUP_Tickables);
+}
+
+
+float UFrameBudgetGovernor::GetPreviewPointScale() const
+{
+    return BoomerangGovernor::PreviewPointScale[Level];
+}
+
+
+void UFrameBudgetGovernor::SetLevel(int32 NewLevel)
+{
+    NewLevel = FMath::Clamp(NewLevel, 0, BoomerangGovernor::MaxLevel);
+    if (NewLevel == Level) return;
+
+    UE_LOG(LogBoomerang, Display, TEXT("Frame budget governor: level %d -> %d (game thread %.2f ms, budget %.2f ms): preview points x%.2f, spawn rate x%.2f, settle cap %d"),
+        Level, NewLevel, Budget.GetAverageMs(), GetDefault<UBoomerangSettings>()->GameThreadBudgetMs,
+        BoomerangGovernor::PreviewPointScale[NewLevel], BoomerangGovernor::SpawnRateScale[NewLevel], BoomerangGovernor::SettleCap[NewLevel]);
+    CSV_EVENT(BoomerangGovernor, TEXT("Level %d -> %d"), Level, NewLevel);
+
+    Level = NewLevel;
+    Budget.SetLevel(Level);
+
+    ApplyLevel();
+}
+
+
+void UFrameBudgetGovernor::ApplyLevel()
+{
+    if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+    {
+        Director->SetSpawnRateScale(BoomerangGovernor::SpawnRateScale[Level]);
+    }
+
+    if (UBoomerangSettleSubsystem* SettleSubsystem = GetWorld()->GetSubsystem<UBoomerangSettleSubsystem>())
+    {
+        SettleSubsystem->SetMaxSimulatingOverride(BoomerangGovernor::SettleCap[Level]);
+    }
+}
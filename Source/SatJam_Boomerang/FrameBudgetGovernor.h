@@ -0,0 +1,48 @@
+// FrameBudgetGovernor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BoomerangBudgetController.h"
+#include "FrameBudgetGovernor.generated.h"
+
+// Watches game-thread time against UBoomerangSettings::GameThreadBudgetMs and steps quality down
+// (preview points, spawn rate, simulating boomerangs) while over budget, and back up with headroom.
+UCLASS()
+class SATJAM_BOOMERANG_API UFrameBudgetGovernor : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // 0 is full quality
+    int32 GetLevel() const { return Level; }
+
+    // Fraction of the configured preview points to use
+    float GetPreviewPointScale() const;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void OnEndFrame();
+
+    void SetLevel(int32 NewLevel);
+
+    // Pushes the current level to spawners and the settle subsystem
+    void ApplyLevel();
+
+    // Level currently applied
+    int32 Level = 0;
+
+    // Smoothed game-thread work and the level it asks for
+    FBoomerangBudgetController Budget;
+
+    FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,306 @@
+// GCChurnMonitor.cpp
+
+#include "GCChurnMonitor.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangStats.h"
+#include "SoakTestSubsystem.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/UObjectArray.h"
+
+CSV_DEFINE_CATEGORY(BoomerangGC, true);
+
+namespace GCChurn
+{
+    struct FClassChurn
+    {
+        int64 Created = 0;
+        int64 Destroyed = 0;
+
+        // Reset every second
+        int32 CreatedThisSecond = 0;
+        int32 DestroyedThisSecond = 0;
+        int32 PeakCreatedPerSecond = 0;
+        int32 PeakDestroyedPerSecond = 0;
+
+        // Reset after every GC pass
+        int32 CreatedSinceGC = 0;
+    };
+
+    // One GC pass that went over the hitch threshold, with the classes that fed it
+    struct FHitch
+    {
+        double Time = 0.0;
+        float DurationMs = 0.f;
+        TArray<TPair<FName, int32>> TopClasses;
+    };
+
+    constexpr int32 NumBlamedClasses = 5;
+
+    static TAutoConsoleVariable<float> CVarHitchMs(
+        TEXT("boomerang.GCChurnHitchMs"),
+        5.f,
+        TEXT("GC passes longer than this are logged as hitches with the classes churned before them."));
+
+    class FMonitor : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+    {
+    public:
+        void Start()
+        {
+            GUObjectArray.AddUObjectCreateListener(this);
+            GUObjectArray.AddUObjectDeleteListener(this);
+
+            PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FMonitor::OnPreGC);
+            PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FMonitor::OnPostGC);
+            TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMonitor::OnSecond), 1.f);
+        }
+
+        void Stop()
+        {
+            GUObjectArray.RemoveUObjectCreateListener(this);
+            GUObjectArray.RemoveUObjectDeleteListener(this);
+
+            FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+            FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+            FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        }
+
+        // Any thread, async loading creates objects too
+        virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+        {
+            const FName ClassName = Object->GetClass()->GetFName();
+
+            FScopeLock Lock(&Mutex);
+            FClassChurn& Churn = Classes.FindOrAdd(ClassName);
+            Churn.Created++;
+            Churn.CreatedThisSecond++;
+            Churn.CreatedSinceGC++;
+            CreatedThisSecond++;
+        }
+
+        virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override
+        {
+            const FName ClassName = Object->GetClass()->GetFName();
+
+            FScopeLock Lock(&Mutex);
+            FClassChurn& Churn = Classes.FindOrAdd(ClassName);
+            Churn.Destroyed++;
+            Churn.DestroyedThisSecond++;
+            DestroyedThisSecond++;
+        }
+
+        virtual void OnUObjectArrayShutdown() override
+        {
+            GUObjectArray.RemoveUObjectCreateListener(this);
+            GUObjectArray.RemoveUObjectDeleteListener(this);
+        }
+
+        void OnPreGC()
+        {
+            GCStartCycles = FPlatformTime::Cycles64();
+        }
+
+        void OnPostGC()
+        {
+            const float DurationMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - GCStartCycles));
+
+            SET_FLOAT_STAT(STAT_LastGCMs, DurationMs);
+            CSV_CUSTOM_STAT(BoomerangGC, GCMs, DurationMs, ECsvCustomStatOp::Set);
+
+            FScopeLock Lock(&Mutex);
+            GCDurationsMs.Add(DurationMs);
+
+            if (DurationMs > CVarHitchMs.GetValueOnGameThread())
+            {
+                FHitch& Hitch = Hitches.AddDefaulted_GetRef();
+                Hitch.Time = FPlatformTime::Seconds();
+                Hitch.DurationMs = DurationMs;
+                Hitch.TopClasses = GetTopClasses([](const FClassChurn& Churn) { return Churn.CreatedSinceGC; }, NumBlamedClasses);
+
+                FString Blame;
+                for (const TPair<FName, int32>& Entry : Hitch.TopClasses)
+                {
+                    Blame += FString::Printf(TEXT(" %s x%d"), *Entry.Key.ToString(), Entry.Value);
+                }
+                UE_LOG(LogBoomerang, Warning, TEXT("GC hitch: %.2f ms, created since last pass:%s"), DurationMs, *Blame);
+
+                SET_DWORD_STAT(STAT_GCHitches, Hitches.Num());
+            }
+
+            for (TPair<FName, FClassChurn>& Entry : Classes)
+            {
+                Entry.Value.CreatedSinceGC = 0;
+            }
+        }
+
+        bool OnSecond(float DeltaTime)
+        {
+            FScopeLock Lock(&Mutex);
+
+            SET_DWORD_STAT(STAT_UObjectsCreatedPerSecond, CreatedThisSecond);
+            SET_DWORD_STAT(STAT_UObjectsDestroyedPerSecond, DestroyedThisSecond);
+            CSV_CUSTOM_STAT(BoomerangGC, UObjectsCreatedPerSecond, CreatedThisSecond, ECsvCustomStatOp::Set);
+            CSV_CUSTOM_STAT(BoomerangGC, UObjectsDestroyedPerSecond, DestroyedThisSecond, ECsvCustomStatOp::Set);
+            CreatedThisSecond = 0;
+            DestroyedThisSecond = 0;
+
+            for (TPair<FName, FClassChurn>& Entry : Classes)
+            {
+                FClassChurn& Churn = Entry.Value;
+                Churn.PeakCreatedPerSecond = FMath::Max(Churn.PeakCreatedPerSecond, Churn.CreatedThisSecond);
+                Churn.PeakDestroyedPerSecond = FMath::Max(Churn.PeakDestroyedPerSecond, Churn.DestroyedThisSecond);
+                Churn.CreatedThisSecond = 0;
+                Churn.DestroyedThisSecond = 0;
+            }
+            return true;
+        }
+
+        // Classes with the largest Metric, largest first. Caller holds the lock.
+        template<typename MetricType>
+        TArray<TPair<FName, int32>> GetTopClasses(MetricType Metric, int32 Count) const
+        {
+            TArray<TPair<FName, int32>> Result;
+            for (const TPair<FName, FClassChurn>& Entry : Classes)
+            {
+                if (const int32 Value = static_cast<int32>(Metric(Entry.Value)))
+                {
+                    Result.Emplace(Entry.Key, Value);
+                }
+            }
+            Result.Sort([](const TPair<FName, int32>& A, const TPair<FName, int32>& B) { return A.Value > B.Value; });
+            if (Result.Num() > Count)
+            {
+                Result.SetNum(Count);
+            }
+            return Result;
+        }
+
+        FCriticalSection Mutex;
+        TMap<FName, FClassChurn> Classes;
+        TArray<float> GCDurationsMs;
+        TArray<FHitch> Hitches;
+        int32 CreatedThisSecond = 0;
+        int32 DestroyedThisSecond = 0;
+
+    private:
+        uint64 GCStartCycles = 0;
+        FDelegateHandle PreGCHandle;
+        FDelegateHandle PostGCHandle;
+        FTSTicker::FDelegateHandle TickerHandle;
+    };
+
+    static FMonitor* Monitor = nullptr;
+
+    static void SetEnabled(bool bEnable)
+    {
+        if (bEnable && !Monitor)
+        {
+            Monitor = new FMonitor();
+            Monitor->Start();
+        }
+        else if (!bEnable && Monitor)
+        {
+            Monitor->Stop();
+            delete Monitor;
+            Monitor = nullptr;
+        }
+    }
+
+    static TAutoConsoleVariable<int32> CVarGCChurn(
+        TEXT("boomerang.GCChurn"),
+        0,
+        TEXT("Count UObject churn per class and attribute GC hitches to it (0 = off, 1 = on)."),
+        FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Var)
+        {
+            SetEnabled(Var->GetInt() != 0);
+        }));
+}
+
+
+void FGCChurnMonitor::Startup()
+{
+    using namespace GCChurn;
+
+    if (FParse::Param(FCommandLine::Get(), TEXT("gcchurn")) || USoakTestSubsystem::IsSoakRun())
+    {
+        CVarGCChurn->Set(1, ECVF_SetByCommandline);
+    }
+}
+
+
+void FGCChurnMonitor::Shutdown()
+{
+    GCChurn::SetEnabled(false);
+}
+
+
+bool FGCChurnMonitor::IsEnabled()
+{
+    return GCChurn::Monitor != nullptr;
+}
+
+
+void FGCChurnMonitor::AppendSummary(TArray<FString>& Lines)
+{
+    using namespace GCChurn;
+
+    if (!Monitor) return;
+
+    FScopeLock Lock(&Monitor->Mutex);
+
+    TArray<float> Sorted = Monitor->GCDurationsMs;
+    Sorted.Sort();
+
+    Lines.Add(FString::Printf(TEXT("GCPasses,%d"), Sorted.Num()));
+    Lines.Add(FString::Printf(TEXT("GCMsP50,%.3f"), Sorted.Num() > 0 ? Sorted[Sorted.Num() / 2] : 0.f));
+    Lines.Add(FString::Printf(TEXT("GCMsMax,%.3f"), Sorted.Num() > 0 ? Sorted.Last() : 0.f));
+    Lines.Add(FString::Printf(TEXT("GCHitchThresholdMs,%.1f"), CVarHitchMs.GetValueOnGameThread()));
+    Lines.Add(FString::Printf(TEXT("GCHitches,%d"), Monitor->Hitches.Num()));
+
+    // Top churned classes, so a gameplay change that adds garbage shows up in the diff
+    for (const TPair<FName, int32>& Entry : Monitor->GetTopClasses([](const FClassChurn& Churn) { return Churn.Created; }, 10))
+    {
+        const FClassChurn& Churn = Monitor->Classes[Entry.Key];
+        Lines.Add(FString::Printf(TEXT("Churn_%s_Created,%lld"), *Entry.Key.ToString(), Churn.Created));
+        Lines.Add(FString::Printf(TEXT("Churn_%s_Destroyed,%lld"), *Entry.Key.ToString(), Churn.Destroyed));
+        Lines.Add(FString::Printf(TEXT("Churn_%s_PeakCreatedPerSecond,%d"), *Entry.Key.ToString(), Churn.PeakCreatedPerSecond));
+    }
+}
+
+
+void FGCChurnMonitor::LogReport()
+{
+    using namespace GCChurn;
+
+    if (!Monitor)
+    {
+        UE_LOG(LogBoomerang, Display, TEXT("GC churn monitor is off, enable with boomerang.GCChurn 1 or -gcchurn."));
+        return;
+    }
+
+    TArray<FString> Lines;
+    AppendSummary(Lines);
+    for (const FString& Line : Lines)
+    {
+        UE_LOG(LogBoomerang, Display, TEXT("  %s"), *Line);
+    }
+
+    FScopeLock Lock(&Monitor->Mutex);
+    for (const FHitch& Hitch : Monitor->Hitches)
+    {
+        FString Blame;
+        for (const TPair<FName, int32>& Entry : Hitch.TopClasses)
+        {
+            Blame += FString::Printf(TEXT(" %s x%d"), *Entry.Key.ToString(), Entry.Value);
+        }
+        UE_LOG(LogBoomerang, Display, TEXT("  Hitch at %.1fs: %.2f ms,%s"), Hitch.Time - GStartTime, Hitch.DurationMs, *Blame);
+    }
+}
+
+
+static FAutoConsoleCommand GCChurnReportCommand(
+    TEXT("boomerang.GCChurnReport"),
+    TEXT("Logs GC pass times, hitches with the classes churned before them, and the most churned classes."),
+    FConsoleCommandDelegate::CreateStatic(&FGCChurnMonitor::LogReport));
@@ -0,0 +1,23 @@
+// GCChurnMonitor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Counts UObject creations and destructions per class, times every garbage collection and
+// blames GC hitches on the classes created since the previous pass.
+// Enable with -gcchurn or boomerang.GCChurn 1 (on by default in -soak runs).
+// Report with boomerang.GCChurnReport, live totals are under "stat Boomerang".
+class SATJAM_BOOMERANG_API FGCChurnMonitor
+{
+public:
+    static void Startup();
+    static void Shutdown();
+
+    static bool IsEnabled();
+
+    // Adds Metric,Value rows for the soak summary
+    static void AppendSummary(TArray<FString>& Lines);
+
+    static void LogReport();
+};
@@ -1,9 +1,22 @@
 // GameManager.cpp
 
 #include "GameManager.h"
+#include "BoomerangStats.h"
+#include "BoomerangMemory.h"
+#include "SatJam_Boomerang.h"
 #include "BoomerangTarget.h"
+#include "BoomerangActor.h"
 #include "TargetSpawner.h"
+#include "SpawnDirectorSubsystem.h"
+#include "PlayerPawnBoomerang.h"
+#include "BoomerangScoreSubsystem.h"
+#include "BoomerangHeatmapSubsystem.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
+#include "EngineUtils.h"
+
+// Set before a hard restart so the reloaded GameManager can report how long the reload took
+static double GPendingHardRestartTime = 0.0;
 
 
 // Sets default values
@@ -12,6 +25,17 @@ AGameManager::AGameManager()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+    // Score is server-authoritative and replicated to clients
+    bReplicates = true;
+    bAlwaysRelevant = true;
+}
+
+
+void AGameManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AGameManager, Score);
 }
 
 
@@ -20,14 +44,24 @@ void AGameManager::BeginPlay()
 {
 	Super::BeginPlay();
 	
+#if !UE_SERVER
     // Force Windowed Mode
     if (GEngine)
     {
         GEngine->Exec(GetWorld(), TEXT("r.SetRes 1280x720w"));
     }
+#endif
 
 
     Score = 0;
+    SessionStartTime = GetWorld()->GetTimeSeconds();
+
+    // Carry the restart timestamp over the level reload
+    if (GPendingHardRestartTime > 0.0)
+    {
+        RestartRequestTime = GPendingHardRestartTime;
+        GPendingHardRestartTime = 0.0;
+    }
 
     // Start the main game timer
     GetWorldTimerManager().SetTimer(
@@ -38,11 +72,14 @@ void AGameManager::BeginPlay()
         false // Only once
     );
 
-    UE_LOG(LogTemp, Warning, TEXT("Game started. Timer set for %.1f seconds."), GameDuration);
+    UE_LOG(LogBoomerang, Warning, TEXT("Game started. Timer set for %.1f seconds."), GameDuration);
 
-    // Create and display UI
-    if (GameUIClass)
+#if !UE_SERVER
+    // Create and display UI, batch sims and servers have no viewport to show it in
+    if (GameUIClass && GetWorld()->GetGameViewport())
     {
+        LLM_SCOPE_BYTAG(Boomerang_GameUI);
+
         GameUI = CreateWidget<UGameUIWidget>(GetWorld(), GameUIClass);
         if (GameUI)
         {
@@ -51,6 +88,7 @@ void AGameManager::BeginPlay()
             GameUI->UpdateScore(Score);
         }
     }
+#endif
 }
 
 
@@ -59,6 +97,14 @@ void AGameManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+    // First tick after a restart, the game is playable again
+    if (RestartRequestTime > 0.0)
+    {
+        const double ElapsedMs = (FPlatformTime::Seconds() - RestartRequestTime) * 1000.0;
+        UE_LOG(LogBoomerang, Warning, TEXT("%s restart to playable: %.2f ms"), bSoftRestart ? TEXT("Soft") : TEXT("Hard"), ElapsedMs);
+        RestartRequestTime = 0.0;
+    }
+
     // Update UI
     UpdateUI();
 
@@ -69,7 +115,8 @@ void AGameManager::Tick(float DeltaTime)
 
         PC->bShowMouseCursor = true;
 
-        if (PC->WasInputKeyJustPressed(EKeys::SpaceBar))
+        // Only the server can restart the session
+        if (PC->WasInputKeyJustPressed(EKeys::SpaceBar) && HasAuthority())
         {
             RestartGame();
         }
@@ -84,12 +131,28 @@ void AGameManager::Tick(float DeltaTime)
 void AGameManager::AddScore(int32 Points)
 {
     Score += Points;
-    UE_LOG(LogTemp, Warning, TEXT("Score: %d"), Score);
+    Hits++;
+    UE_LOG(LogBoomerang, Verbose, TEXT("Score: %d"), Score);
+}
+
+
+void AGameManager::RegisterThrow()
+{
+    Throws++;
+}
+
+
+float AGameManager::GetSessionDuration() const
+{
+    return GetWorld()->GetTimeSeconds() - SessionStartTime;
 }
 
 
 void AGameManager::UpdateUI()
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_UpdateUI);
+    LLM_SCOPE_BYTAG(Boomerang_GameUI);
+
     if (GameUI)
     {
         // Get remaining time from timer
@@ -104,18 +167,16 @@ void AGameManager::UpdateUI()
 
 void AGameManager::StopSpawner()
 {
-    ATargetSpawner* targetSpawner = Cast<ATargetSpawner>(
-        UGameplayStatics::GetActorOfClass(GetWorld(), ATargetSpawner::StaticClass())
-    );
+    USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>();
 
-    if(targetSpawner)
+    if (Director && Director->GetPrimarySpawner())
     {
-        targetSpawner->StopSpawning();
-        UE_LOG(LogTemp, Warning, TEXT("Spawner stopped."));
+        Director->StopAll();
+        UE_LOG(LogBoomerang, Warning, TEXT("Spawners stopped."));
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("No TargetSpawner found in the level!"));
+        UE_LOG(LogBoomerang, Error, TEXT("No TargetSpawner found in the level!"));
 	}
 }
 
@@ -129,18 +190,33 @@ void AGameManager::DestroyAllTargets()
     {
         if (Actor)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Destroying target: %s"), *Actor->GetName());
+            UE_LOG(LogBoomerang, Verbose, TEXT("Destroying target: %s"), *Actor->GetName());
             Actor->Destroy();
         }
     }
 }
 
 
+void AGameManager::DestroyAllBoomerangs()
+{
+    TArray<AActor*> FoundBoomerangs;
+    UGameplayStatics::GetAllActorsOfClass(GetWorld(), ABoomerangActor::StaticClass(), FoundBoomerangs);
+
+    for (AActor* Actor : FoundBoomerangs)
+    {
+        if (Actor)
+        {
+            Actor->Destroy(); // notifies the owning pawn
+        }
+    }
+}
+
+
 void AGameManager::OnGameEnd()
 {
     if (gameEnded) return; // Prevent multiple calls
 
-    UE_LOG(LogTemp, Warning, TEXT("Time's up! Stopping spawners and clearing enemies."));
+    UE_LOG(LogBoomerang, Warning, TEXT("Time's up! Stopping spawners and clearing enemies."));
 
     StopSpawner();
     DestroyAllTargets();
@@ -151,19 +227,114 @@ void AGameManager::OnGameEnd()
     }
 
     gameEnded = true;
+
+    SaveSession();
+
+    if (UBoomerangHeatmapSubsystem* Heatmap = GetWorld()->GetSubsystem<UBoomerangHeatmapSubsystem>())
+    {
+        Heatmap->EndSession();
+    }
+}
+
+
+void AGameManager::SaveSession()
+{
+    UBoomerangScoreSubsystem* ScoreStore = GetGameInstance() ? GetGameInstance()->GetSubsystem<UBoomerangScoreSubsystem>() : nullptr;
+    if (!ScoreStore) return;
+
+    FBoomerangSessionRecord Record;
+    Record.Score = Score;
+    Record.Duration = GetSessionDuration();
+    Record.Throws = static_cast<uint16>(FMath::Min(Throws, static_cast<int32>(MAX_uint16)));
+    Record.Hits = static_cast<uint16>(FMath::Min(Hits, static_cast<int32>(MAX_uint16)));
+    Record.Timestamp = FDateTime::UtcNow().GetTicks();
+
+    USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>();
+
+    if (ATargetSpawner* targetSpawner = Director ? Director->GetPrimarySpawner() : nullptr)
+    {
+        Record.Seed = targetSpawner->GetSeed();
+    }
+
+    // Disk writes happen in the background
+    ScoreStore->RecordSession(Record);
 }
 
 
 void AGameManager::RestartGame()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Restarting game..."));
+    UE_LOG(LogBoomerang, Warning, TEXT("Restarting game..."));
+
+    if (bSoftRestart)
+    {
+        MulticastSoftRestart();
+        return;
+    }
+
+    GPendingHardRestartTime = FPlatformTime::Seconds();
     UGameplayStatics::OpenLevel(this, FName(*GetWorld()->GetName())); // reload current level
 }
 
 
+void AGameManager::MulticastSoftRestart_Implementation()
+{
+    RestartRequestTime = FPlatformTime::Seconds();
+    SoftRestart();
+}
+
+
+void AGameManager::SoftRestart()
+{
+    // Clear everything the last session left behind
+    DestroyAllBoomerangs();
+    DestroyAllTargets();
+
+    Score = 0;
+    Throws = 0;
+    Hits = 0;
+    SessionStartTime = GetWorld()->GetTimeSeconds();
+    gameEnded = false;
+
+    // Restart the main game timer
+    GetWorldTimerManager().SetTimer(
+        GameTimerHandle,
+        this,
+        &AGameManager::OnGameEnd,
+        GameDuration,
+        false // Only once
+    );
+
+    // Restart target spawning
+    if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+    {
+        Director->StartAll();
+    }
+
+    if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+    {
+        PC->bShowMouseCursor = false;
+    }
+
+    // Reset aim and trajectory preview of every thrower, bots included
+    for (TActorIterator<APlayerPawnBoomerang> It(GetWorld()); It; ++It)
+    {
+        It->ResetForRestart();
+    }
+
+    if (GameUI)
+    {
+        GameUI->HideGameOverMessage();
+        GameUI->UpdateTime(FMath::RoundToInt(GameDuration));
+        GameUI->UpdateScore(Score);
+    }
+
+    UE_LOG(LogBoomerang, Warning, TEXT("Game restarted in place. Timer set for %.1f seconds."), GameDuration);
+}
+
+
 void AGameManager::QuitGame()
 {
-    UE_LOG(LogTemp, Warning, TEXT("Quitting game..."));
+    UE_LOG(LogBoomerang, Warning, TEXT("Quitting game..."));
     APlayerController* PC = GetWorld()->GetFirstPlayerController();
     UKismetSystemLibrary::QuitGame(GetWorld(), PC, EQuitPreference::Quit, true);
 }
\ No newline at end of file
@@ -16,10 +16,18 @@ public:
 	// Sets default values for this actor's properties
 	AGameManager();
 
+	UPROPERTY(Replicated)
 	int32 Score = 0;
 
 	void AddScore(int32 Points);
 
+    // Called by the player pawn whenever a boomerang is thrown
+    void RegisterThrow();
+
+    // Session stats recorded when the game ends
+    int32 Throws = 0;
+    int32 Hits = 0;
+
     // Add UI reference
     UPROPERTY(EditDefaultsOnly, Category = "UI")
     TSubclassOf<UGameUIWidget> GameUIClass;
@@ -30,6 +38,19 @@ public:
     // Timer update helper
     void UpdateUI();
 
+    bool IsGameEnded() const { return gameEnded; }
+
+    // Seconds since the current session started
+    float GetSessionDuration() const;
+
+    // Restarts the session (in place when bSoftRestart is set)
+    UFUNCTION()
+    void RestartGame();
+
+    // Resets the session in place without reloading the map, whatever bSoftRestart says.
+    // Worlds without a game instance (batch sims) must restart this way, they can't reload a level.
+    void SoftRestart();
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -38,6 +59,8 @@ public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 private:
     // How long the game lasts in seconds (1 minute = 60 seconds)
     UPROPERTY(EditAnywhere, Category = "Game Rules")
@@ -55,8 +78,25 @@ private:
     // Helper function to destroy all existing targets
     void DestroyAllTargets();
 
-    UFUNCTION()
-    void RestartGame();
+    // Server restarts the session on every machine
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastSoftRestart();
+
+    // Helper function to destroy all boomerangs still in flight or settling
+    void DestroyAllBoomerangs();
+
+    // Restart in place instead of reloading the level through OpenLevel
+    UPROPERTY(EditAnywhere, Category = "Game Rules")
+    bool bSoftRestart = true;
+
+    // World time the current session started
+    float SessionStartTime = 0.f;
+
+    // Sends the finished session to the score store
+    void SaveSession();
+
+    // Time the last restart was requested, cleared once the game is playable again
+    double RestartRequestTime = 0.0;
 
     UFUNCTION()
     void QuitGame();
@@ -30,3 +30,13 @@ void UGameUIWidget::ShowGameOverMessage()
         RetryText->SetVisibility(ESlateVisibility::Visible);
     }
 }
+
+
+void UGameUIWidget::HideGameOverMessage()
+{
+    if (StatusText)
+    {
+        StatusText->SetVisibility(ESlateVisibility::Hidden);
+        RetryText->SetVisibility(ESlateVisibility::Hidden);
+    }
+}
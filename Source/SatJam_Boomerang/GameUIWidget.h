@@ -28,4 +28,5 @@ public:
     void UpdateTime(int32 SecondsLeft);
     void UpdateScore(int32 NewScore);
     void ShowGameOverMessage();
+    void HideGameOverMessage();
 };
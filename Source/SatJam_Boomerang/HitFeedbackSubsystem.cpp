@@ -0,0 +1,156 @@
+// HitFeedbackSubsystem.cpp
+
+#include "HitFeedbackSubsystem.h"
+#include "BoomerangSettings.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Engine/World.h"
+
+
+bool UHitFeedbackSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Server builds never load effects or sounds
+#if UE_SERVER
+    return false;
+#else
+    return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+
+bool UHitFeedbackSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UHitFeedbackSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Nobody to show feedback to
+    if (InWorld.GetNetMode() == NM_DedicatedServer) return;
+
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    MaxSpawnsPerFrame = Settings->FeedbackMaxSpawnsPerFrame;
+    CullDistanceSq = FMath::Square(Settings->FeedbackCullDistance);
+
+    // Loaded once here so nothing is loaded on the gameplay path
+    BuildPool(Pools[(int32)EHitFeedback::TargetPop], Settings->TargetPopEffect.LoadSynchronous(), Settings->TargetPopSound.LoadSynchronous(), Settings->FeedbackPoolSize);
+    BuildPool(Pools[(int32)EHitFeedback::GroundImpact], Settings->GroundImpactEffect.LoadSynchronous(), Settings->GroundImpactSound.LoadSynchronous(), Settings->FeedbackPoolSize);
+
+    bEnabled = true;
+}
+
+
+void UHitFeedbackSubsystem::BuildPool(FHitFeedbackPool& Pool, UNiagaraSystem* Effect, USoundBase* Sound, int32 Size)
+{
+    UWorld* World = GetWorld();
+    AWorldSettings* Outer = World->GetWorldSettings();
+
+    for (int32 i = 0; i < Size; ++i)
+    {
+        if (Effect)
+        {
+            UNiagaraComponent* EffectComp = NewObject<UNiagaraComponent>(Outer);
+            EffectComp->SetAutoActivate(false);
+            EffectComp->SetAutoDestroy(false);
+            EffectComp->SetAsset(Effect);
+            EffectComp->RegisterComponentWithWorld(World);
+            Pool.Effects.Add(EffectComp);
+        }
+
+        if (Sound)
+        {
+            UAudioComponent* SoundComp = NewObject<UAudioComponent>(Outer);
+            SoundComp->bAutoActivate = false;
+            SoundComp->bAutoDestroy = false;
+            SoundComp->SetSound(Sound);
+            SoundComp->RegisterComponentWithWorld(World);
+            Pool.Sounds.Add(SoundComp);
+        }
+    }
+}
+
+
+void UHitFeedbackSubsystem::Deinitialize()
+{
+    for (FHitFeedbackPool& Pool : Pools)
+    {
+        for (UNiagaraComponent* EffectComp : Pool.Effects)
+        {
+            if (EffectComp)
+            {
+                EffectComp->DestroyComponent();
+            }
+        }
+
+        for (UAudioComponent* SoundComp : Pool.Sounds)
+        {
+            if (SoundComp)
+            {
+                SoundComp->DestroyComponent();
+            }
+        }
+
+        Pool.Effects.Empty();
+        Pool.Sounds.Empty();
+    }
+
+    bEnabled = false;
+
+    Super::Deinitialize();
+}
+
+
+void UHitFeedbackSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SpawnsThisFrame = 0;
+}
+
+
+TStatId UHitFeedbackSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UHitFeedbackSubsystem, STATGROUP_Tickables);
+}
+
+
+void UHitFeedbackSubsystem::Play(EHitFeedback Type, const FVector& Location)
+{
+    if (!bEnabled || SpawnsThisFrame >= MaxSpawnsPerFrame) return;
+
+    // Cull against the local player's camera
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    if (!PC || !PC->PlayerCameraManager) return;
+
+    if (FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), Location) > CullDistanceSq) return;
+
+    SpawnsThisFrame++;
+
+    FHitFeedbackPool& Pool = Pools[(int32)Type];
+
+    // Reuse the oldest component, restarting it if it is still playing
+    if (Pool.Effects.Num() > 0)
+    {
+        UNiagaraComponent* EffectComp = Pool.Effects[Pool.NextEffect];
+        Pool.NextEffect = (Pool.NextEffect + 1) % Pool.Effects.Num();
+
+        EffectComp->SetWorldLocation(Location);
+        EffectComp->Activate(true);
+    }
+
+    if (Pool.Sounds.Num() > 0)
+    {
+        UAudioComponent* SoundComp = Pool.Sounds[Pool.NextSound];
+        Pool.NextSound = (Pool.NextSound + 1) % Pool.Sounds.Num();
+
+        SoundComp->SetWorldLocation(Location);
+        SoundComp->Play();
+    }
+}
@@ -0,0 +1,68 @@
+// HitFeedbackSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitFeedbackSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UAudioComponent;
+
+UENUM()
+enum class EHitFeedback : uint8
+{
+    TargetPop,
+    GroundImpact,
+};
+
+// Fixed set of components for one event type, reused round-robin
+USTRUCT()
+struct FHitFeedbackPool
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<TObjectPtr<UNiagaraComponent>> Effects;
+
+    UPROPERTY()
+    TArray<TObjectPtr<UAudioComponent>> Sounds;
+
+    int32 NextEffect = 0;
+    int32 NextSound = 0;
+};
+
+
+// Pre-warmed, recycled effect and sound components for gameplay feedback.
+// Nothing is allocated on the gameplay path: components are created at BeginPlay and reused round-robin.
+UCLASS()
+class SATJAM_BOOMERANG_API UHitFeedbackSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Plays the effect and sound for an event, skipped when over the frame cap or too far away
+    void Play(EHitFeedback Type, const FVector& Location);
+
+protected:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void BuildPool(FHitFeedbackPool& Pool, class UNiagaraSystem* Effect, class USoundBase* Sound, int32 Size);
+
+    // Indexed by EHitFeedback
+    UPROPERTY()
+    FHitFeedbackPool Pools[2];
+
+    int32 SpawnsThisFrame = 0;
+    int32 MaxSpawnsPerFrame = 4;
+    float CullDistanceSq = 0.f;
+    bool bEnabled = false;
+};
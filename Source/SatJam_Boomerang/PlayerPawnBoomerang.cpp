@@ -1,12 +1,24 @@
 // PlayerPawnBoomerang.cpp
 
 #include "PlayerPawnBoomerang.h"
+#include "BoomerangStats.h"
+#include "BoomerangMemory.h"
 #include "BoomerangActor.h"
+#include "GameManager.h"
+#include "BoomerangTelemetry.h"
+#include "BoomerangHeatmapSubsystem.h"
+#include "BoomerangDistanceFieldSubsystem.h"
+#include "BoomerangTrajectoryLibrary.h"
+#include "FrameBudgetGovernor.h"
+#include "ThrowLatencyTracker.h"
+#include "Kismet/GameplayStatics.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SplineComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "Tasks/Task.h"
 
 
 APlayerPawnBoomerang::APlayerPawnBoomerang()
@@ -38,10 +50,21 @@ void APlayerPawnBoomerang::BeginPlay()
 }
 
 
+void APlayerPawnBoomerang::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // The preview task writes into this pawn and queries its world
+    PreviewTask.Wait();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+
 void APlayerPawnBoomerang::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Preview and camera are only for a local viewer, servers skip both
+#if !UE_SERVER
     // Update trajectory preview every tick
     UpdateTrajectoryPreview();
 
@@ -51,6 +74,7 @@ void APlayerPawnBoomerang::Tick(float DeltaTime)
     // Apply camera location and rotation
     Camera->SetWorldLocation(GetActorLocation() + RotatedOffset);
     Camera->SetWorldRotation(ControlRotation);
+#endif
 
 }
 
@@ -72,48 +96,169 @@ void APlayerPawnBoomerang::SetupPlayerInputComponent(UInputComponent* PlayerInpu
 void APlayerPawnBoomerang::Turn(float Value)
 {
     if (Value != 0.f)
+    {
         ControlRotation.Yaw += Value;
+        RequestTrajectoryPreview();
+    }
 }
 
 void APlayerPawnBoomerang::LookUp(float Value)
 {
     if (Value != 0.f)
+    {
         ControlRotation.Pitch = FMath::Clamp(ControlRotation.Pitch + Value, -89.f, 89.f);
+        RequestTrajectoryPreview();
+    }
+}
+
+
+void APlayerPawnBoomerang::SetAimRotation(const FRotator& NewAim)
+{
+    ControlRotation = FRotator(FMath::Clamp(NewAim.Pitch, -89.f, 89.f), NewAim.Yaw, 0.f);
+    RequestTrajectoryPreview();
 }
 
 
 void APlayerPawnBoomerang::ThrowBoomerang()
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_ThrowBoomerang);
+
     if (!BoomerangClass || ActiveBoomerang)
         return;
 
-    // Ensure trajectory preview is up to date
-    UpdateTrajectoryPreview();
+    // Bots throw through here too, only time the player's own throws
+    if (IsLocallyControlled() && IsPlayerControlled())
+    {
+        FThrowLatencyTracker::MarkPressed();
+    }
+
+    // Clients only send their aim, the server builds and spawns the throw
+    if (!HasAuthority())
+    {
+        ServerThrowBoomerang(FRotator::CompressAxisToShort(ControlRotation.Yaw), FRotator::CompressAxisToShort(ControlRotation.Pitch));
+        return;
+    }
+
+    SpawnThrow(ControlRotation);
+}
+
+
+void APlayerPawnBoomerang::ServerThrowBoomerang_Implementation(uint16 Yaw, uint16 Pitch)
+{
+    if (!BoomerangClass || ActiveBoomerang)
+        return;
 
-    TArray<FVector> PathPoints = SampleTrajectoryPoints();
-    if (PathPoints.Num() < 2) return;
+    const FRotator Aim(
+        FMath::Clamp(FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(Pitch)), -89.f, 89.f),
+        FRotator::DecompressAxisFromShort(Yaw),
+        0.f);
 
-    FVector SpawnLocation = PathPoints[0];
-    FRotator SpawnRotation = Camera->GetComponentRotation();
+    SpawnThrow(Aim);
+}
+
+
+void APlayerPawnBoomerang::SpawnThrow(const FRotator& Aim)
+{
+    const FBoomerangThrowDescriptor Descriptor = MakeThrowDescriptor(Aim);
+
+    if (ABoomerangActor* Boomerang = SpawnBoomerangFromDescriptor(Descriptor, false))
+    {
+        FBoomerangTelemetry::Record(EBoomerangEvent::Throw, FVector(Descriptor.Start), Boomerang->GetUniqueID());
+
+        if (UBoomerangHeatmapSubsystem* Heatmap = GetWorld()->GetSubsystem<UBoomerangHeatmapSubsystem>())
+        {
+            Heatmap->RecordThrow(Aim);
+        }
+
+        AGameManager* GameManager = Cast<AGameManager>(
+            UGameplayStatics::GetActorOfClass(GetWorld(), AGameManager::StaticClass())
+        );
+
+        if (GameManager)
+        {
+            GameManager->RegisterThrow();
+        }
+
+        // Clients simulate the same flight locally from the descriptor
+        if (GetNetMode() != NM_Standalone)
+        {
+            FBoomerangNetStats::RecordThrow(Descriptor);
+            MulticastThrowBoomerang(Descriptor);
+        }
+    }
+}
+
+
+void APlayerPawnBoomerang::MulticastThrowBoomerang_Implementation(const FBoomerangThrowDescriptor& Descriptor)
+{
+    // The server already spawned the authoritative boomerang
+    if (HasAuthority())
+        return;
+
+    SpawnBoomerangFromDescriptor(Descriptor, true);
+}
+
+
+ABoomerangActor* APlayerPawnBoomerang::SpawnBoomerangFromDescriptor(const FBoomerangThrowDescriptor& Descriptor, bool bCosmetic)
+{
+    if (!BoomerangClass)
+        return nullptr;
+
+    LLM_SCOPE_BYTAG(Boomerang);
 
     FActorSpawnParameters SpawnParams;
     SpawnParams.Owner = this;
 
-    ABoomerangActor* Boomerang = GetWorld()->SpawnActor<ABoomerangActor>(BoomerangClass, SpawnLocation, SpawnRotation, SpawnParams);
+    ABoomerangActor* Boomerang = GetWorld()->SpawnActor<ABoomerangActor>(BoomerangClass, FVector(Descriptor.Start), Descriptor.GetAim(), SpawnParams);
     if (Boomerang)
     {
-        Boomerang->InitializeWithPath(PathPoints, this);
+        Boomerang->InitializeFromDescriptor(Descriptor, this, bCosmetic);
         ActiveBoomerang = Boomerang;
 
+        // Same condition as MarkPressed, a local bot's boomerang must not end the player's sample
+        if (IsLocallyControlled() && IsPlayerControlled())
+        {
+            FThrowLatencyTracker::MarkSpawned(Boomerang);
+        }
+
         // Hide trajectory while boomerang is active
         TrajectorySpline->SetVisibility(false);
     }
+
+    return Boomerang;
+}
+
+
+FBoomerangThrowDescriptor APlayerPawnBoomerang::MakeThrowDescriptor(const FRotator& Aim) const
+{
+    float UseDistance = Distance;
+    float UseCurveRadius = CurveRadius;
+    float UseFlightTime = 2.5f;
+    uint8 UseShape = 0;
+
+    // Use class defaults if available
+    if (BoomerangClass)
+    {
+        if (ABoomerangActor* CDO = Cast<ABoomerangActor>(BoomerangClass->GetDefaultObject()))
+        {
+            UseDistance = CDO->Distance;
+            UseCurveRadius = CDO->CurveRadius;
+            UseFlightTime = CDO->GetTotalFlightTime();
+            UseShape = UBoomerangTrajectoryLibrary::GetShapeId(CDO->TrajectoryShape);
+        }
+    }
+
+    // Use player's location as path start
+    return FBoomerangThrowDescriptor::Make(GetActorLocation(), Aim, UseDistance, UseCurveRadius, UseFlightTime, NumSplinePoints, UseShape);
 }
 
 
 // Trajectory spline preview
 void APlayerPawnBoomerang::UpdateTrajectoryPreview()
 {
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_UpdateTrajectoryPreview);
+    LLM_SCOPE_BYTAG(Boomerang_Trajectory);
+
     if (!TrajectorySpline) return;
 
     // Hide preview if boomerang exists
@@ -124,66 +269,91 @@ void APlayerPawnBoomerang::UpdateTrajectoryPreview()
         return;
     }
 
-    TrajectorySpline->ClearSplinePoints();
-
-    // Use player's location as spline start
-    FVector Start = GetActorLocation();
-    FVector Forward = ControlRotation.Vector().GetSafeNormal();
-    FVector Right = FVector::CrossProduct(Forward, FVector::UpVector).GetSafeNormal();
-
-    float UseDistance = Distance;
-    float UseCurveRadius = CurveRadius;
+    // Only the local human player sees a preview, bots and other players' pawns skip it
+    if (!IsLocallyControlled() || !IsPlayerControlled()) return;
 
-    // Use class defaults if available
-    if (BoomerangClass)
+    // A finished preview becomes the front buffer, only its finished points touch the spline
+    if (bPreviewPending && PreviewTask.IsCompleted())
     {
-        if (ABoomerangActor* CDO = Cast<ABoomerangActor>(BoomerangClass->GetDefaultObject()))
+        bPreviewPending = false;
+        FrontPreview = 1 - FrontPreview;
+
+        TrajectorySpline->ClearSplinePoints(false);
+        for (const FVector& Point : PreviewPoints[FrontPreview])
         {
-            UseDistance = CDO->Distance;
-            UseCurveRadius = CDO->CurveRadius;
+            TrajectorySpline->AddSplinePoint(Point, ESplineCoordinateSpace::World, false);
         }
+        TrajectorySpline->UpdateSpline();
+        INC_DWORD_STAT(STAT_SplineRebuilds);
+
+        TrajectorySpline->SetVisibility(true);
     }
 
-    // Sample trajectory points along the path
-    for (int32 i = 0; i <= NumSplinePoints; ++i)
+    // Picks up aim changes that arrived while a task was in flight, and moves or budget changes without input
+    RequestTrajectoryPreview();
+
+    // Draw debug lines for visual clarity
+    const TArray<FVector>& PathPoints = PreviewPoints[FrontPreview];
+    for (int32 i = 1; i < PathPoints.Num(); ++i)
     {
-		// divide trajectory to evenly spaced points
-		// T ranges from 0 to 1
-        float T = NumSplinePoints > 0 ? static_cast<float>(i) / NumSplinePoints : 0.f;
+        DrawDebugLine(GetWorld(), PathPoints[i - 1], PathPoints[i], FColor::Green, false, -1.f, 0, 2.f);
+    }
+}
 
-		float sinPI_T = FMath::Sin(T * PI); // forward motion: goes forward halfway through then comes back (0 > 1 > 0)
-		float sideSin = FMath::Sin(T * 2.f * PI);   // sideways swing: does a full right-left oscillation (0 > 1 > 0 > -1 > 0)
 
-		FVector Outward = Start + Forward * (sinPI_T * UseDistance);    // scale forward motion with distance
-		FVector SideOffset = Right * (sideSin * UseCurveRadius);    // scale sideways motion with curve radius
+void APlayerPawnBoomerang::RequestTrajectoryPreview()
+{
+#if !UE_SERVER
+    if (ActiveBoomerang || !IsLocallyControlled() || !IsPlayerControlled()) return;
+
+    // One task at a time, the tick after it lands launches the newest aim
+    if (!PreviewTask.IsCompleted()) return;
 
-        TrajectorySpline->AddSplinePoint(Outward + SideOffset, ESplineCoordinateSpace::World);
+    // Same quantized path the boomerang will fly, with fewer points when over the frame budget
+    FBoomerangThrowDescriptor Descriptor = MakeThrowDescriptor(ControlRotation);
+    if (const UFrameBudgetGovernor* Governor = GetWorld()->GetSubsystem<UFrameBudgetGovernor>())
+    {
+        Descriptor.NumSegments = static_cast<uint8>(FMath::Max(4, FMath::RoundToInt(Descriptor.NumSegments * Governor->GetPreviewPointScale())));
     }
 
-    TrajectorySpline->SetVisibility(true);
+    if (Descriptor == PreviewDescriptor) return;
+    PreviewDescriptor = Descriptor;
 
-    // Draw debug lines for visual clarity
-    for (int32 i = 1; i <= NumSplinePoints; ++i)
+    float SweepRadius = 12.f;
+    if (BoomerangClass)
     {
-        FVector P1 = TrajectorySpline->GetLocationAtSplinePoint(i - 1, ESplineCoordinateSpace::World);
-        FVector P2 = TrajectorySpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
-        DrawDebugLine(GetWorld(), P1, P2, FColor::Green, false, -1.f, 0, 2.f);
+        SweepRadius = BoomerangClass->GetDefaultObject<ABoomerangActor>()->GetSweepRadius();
     }
+
+    bPreviewPending = true;
+    PreviewTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [StaticCollision = GetWorld()->GetSubsystem<UBoomerangDistanceFieldSubsystem>(), Descriptor, SweepRadius, &BackBuffer = PreviewPoints[1 - FrontPreview]]()
+        {
+            ComputeTrajectoryPreview(StaticCollision, Descriptor, SweepRadius, BackBuffer);
+        });
+#endif
 }
 
 
-// Sample spline points for boomerang path
-TArray<FVector> APlayerPawnBoomerang::SampleTrajectoryPoints() const
+void APlayerPawnBoomerang::ComputeTrajectoryPreview(const UBoomerangDistanceFieldSubsystem* StaticCollision, const FBoomerangThrowDescriptor& Descriptor, float SweepRadius, TArray<FVector>& OutPoints)
 {
-    TArray<FVector> Points;
-    if (!TrajectorySpline) return Points;
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_ComputeTrajectoryPreview);
+    LLM_SCOPE_BYTAG(Boomerang_Trajectory);
 
-    const int32 Count = TrajectorySpline->GetNumberOfSplinePoints();
-    for (int32 i = 0; i < Count; ++i)
+    Descriptor.BuildPath(OutPoints);
+    if (!StaticCollision) return;
+
+    // Cut the path where the boomerang would settle, with the same sweep the flight schedules its wall hit with
+    for (int32 i = 1; i < OutPoints.Num(); ++i)
     {
-        Points.Add(TrajectorySpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World));
+        FHitResult Hit;
+        if (StaticCollision->SweepStatic(OutPoints[i - 1], OutPoints[i], SweepRadius, Hit))
+        {
+            OutPoints.SetNum(i, EAllowShrinking::No);
+            OutPoints.Add(Hit.Location);
+            break;
+        }
     }
-    return Points;
 }
 
 
@@ -191,5 +361,18 @@ TArray<FVector> APlayerPawnBoomerang::SampleTrajectoryPoints() const
 void APlayerPawnBoomerang::NotifyOwnerDestroyed()
 {
     ActiveBoomerang = nullptr;
-    TrajectorySpline->SetVisibility(true); // show preview again
+
+    // Spline was cleared during the flight, recompute so the preview comes back
+    PreviewDescriptor = FBoomerangThrowDescriptor();
+    RequestTrajectoryPreview();
+}
+
+
+// Called by GameManager when the game restarts in place
+void APlayerPawnBoomerang::ResetForRestart()
+{
+    ActiveBoomerang = nullptr;
+    ControlRotation = FRotator::ZeroRotator;
+    PreviewDescriptor = FBoomerangThrowDescriptor();
+    RequestTrajectoryPreview();
 }
@@ -6,10 +6,13 @@
 #include "GameFramework/Pawn.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SplineComponent.h"
+#include "BoomerangThrowDescriptor.h"
+#include "Tasks/Task.h"
 #include "PlayerPawnBoomerang.generated.h"
 
 class UCameraComponent;
 class ABoomerangActor;
+class UBoomerangDistanceFieldSubsystem;
 
 UCLASS()
 class SATJAM_BOOMERANG_API APlayerPawnBoomerang : public APawn
@@ -21,6 +24,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -29,6 +33,23 @@ public:
     // Called by the boomerang when destroyed so the pawn can update state
     void NotifyOwnerDestroyed();
 
+    // Called by the GameManager on a soft restart to reset aim and preview
+    void ResetForRestart();
+
+    // Throw along the current aim, also used by scripted and AI throws
+    void ThrowBoomerang();
+
+    // Aim used for the preview and the next throw
+    void SetAimRotation(const FRotator& NewAim);
+    const FRotator& GetAimRotation() const { return ControlRotation; }
+
+    bool HasActiveBoomerang() const { return ActiveBoomerang != nullptr; }
+
+    TSubclassOf<ABoomerangActor> GetBoomerangClass() const { return BoomerangClass; }
+
+    // Throw parameters for the given aim, shared by the preview and the actual throw
+    FBoomerangThrowDescriptor MakeThrowDescriptor(const FRotator& Aim) const;
+
 private:
     /** Components */
     UPROPERTY(VisibleAnywhere)
@@ -66,11 +87,36 @@ private:
     // Input callbacks
     void LookUp(float Value);
     void Turn(float Value);
-    void ThrowBoomerang();
 
-    // Update spline preview based on camera rotation
+    // Client sends only its aim, compressed to two shorts
+    UFUNCTION(Server, Reliable)
+    void ServerThrowBoomerang(uint16 Yaw, uint16 Pitch);
+
+    // Server sends the throw descriptor so clients can simulate the flight
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastThrowBoomerang(const FBoomerangThrowDescriptor& Descriptor);
+
+    // Spawns the authoritative boomerang (server or standalone)
+    void SpawnThrow(const FRotator& Aim);
+
+    ABoomerangActor* SpawnBoomerangFromDescriptor(const FBoomerangThrowDescriptor& Descriptor, bool bCosmetic);
+
+    // Commits the last finished preview to the spline and draws it
     void UpdateTrajectoryPreview();
 
-    // Sample spline points into an array
-    TArray<FVector> SampleTrajectoryPoints() const;
+    // Starts computing the preview for the current aim on a worker, called from input handling
+    void RequestTrajectoryPreview();
+
+    // Builds the path and clips it against world static geometry, runs on a worker
+    static void ComputeTrajectoryPreview(const UBoomerangDistanceFieldSubsystem* StaticCollision, const FBoomerangThrowDescriptor& Descriptor, float SweepRadius, TArray<FVector>& OutPoints);
+
+    // Double buffered preview: the task fills the back buffer, the game thread only reads the front one
+    TArray<FVector> PreviewPoints[2];
+    int32 FrontPreview = 0;
+
+    UE::Tasks::FTask PreviewTask;
+    bool bPreviewPending = false;
+
+    // Descriptor of the last launched preview, so an unchanged aim isn't recomputed
+    FBoomerangThrowDescriptor PreviewDescriptor;
 };
@@ -8,10 +8,16 @@ public class SatJam_Boomerang : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "AIModule", "DeveloperSettings", "Niagara", "SignificanceManager", "BoomerangMath" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// Verbose gameplay logging is compiled out of shipping builds
+		if (Target.Configuration == UnrealTargetConfiguration.Shipping)
+		{
+			PublicDefinitions.Add("BOOMERANG_LOG_COMPILE_VERBOSITY=Warning");
+		}
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
@@ -1,6 +1,27 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SatJam_Boomerang.h"
+#include "BoomerangTelemetry.h"
+#include "GCChurnMonitor.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, SatJam_Boomerang, "SatJam_Boomerang" );
+DEFINE_LOG_CATEGORY(LogBoomerang);
+
+
+class FSatJamBoomerangModule : public FDefaultGameModuleImpl
+{
+public:
+    virtual void StartupModule() override
+    {
+        FBoomerangTelemetry::Startup();
+        FGCChurnMonitor::Startup();
+    }
+
+    virtual void ShutdownModule() override
+    {
+        FGCChurnMonitor::Shutdown();
+        FBoomerangTelemetry::Shutdown();
+    }
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FSatJamBoomerangModule, SatJam_Boomerang, "SatJam_Boomerang" );
@@ -4,3 +4,9 @@
 
 #include "CoreMinimal.h"
 
+// Anything more verbose than this is compiled out (set per configuration in SatJam_Boomerang.Build.cs)
+#ifndef BOOMERANG_LOG_COMPILE_VERBOSITY
+#define BOOMERANG_LOG_COMPILE_VERBOSITY All
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBoomerang, Log, BOOMERANG_LOG_COMPILE_VERBOSITY);
@@ -0,0 +1,230 @@
+// SimBatchCommandlet.cpp
+
+#include "SimBatchCommandlet.h"
+#include "SatJam_Boomerang.h"
+#include "GameManager.h"
+#include "TargetSpawner.h"
+#include "PlayerPawnBoomerang.h"
+#include "BoomerangBotController.h"
+#include "EngineUtils.h"
+#include "Engine/Engine.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "GameFramework/WorldSettings.h"
+#include "Containers/Ticker.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+
+USimBatchCommandlet::USimBatchCommandlet()
+{
+    IsClient = false;
+    IsServer = true;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+
+namespace SimBatch
+{
+    // Collect garbage every this many steps, destroyed targets and boomerangs pile up otherwise
+    constexpr int32 GCInterval = 600;
+
+    struct FSimWorld
+    {
+        UWorld* World = nullptr;
+        AGameManager* GameManager = nullptr;
+        int32 Seed = 0;
+        float SpawnInterval = 0.f;
+        int32 SessionsDone = 0;
+    };
+
+    // Empty game world with its own instance of the map streamed in and begun play.
+    // No game mode or game instance, the game manager and spawners in the map run the session.
+    static UWorld* CreateSimWorld(const FString& MapPath, int32 Index)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, *FString::Printf(TEXT("SimWorld_%d"), Index));
+        World->AddToRoot();
+        World->InitializeActorsForPlay(FURL());
+
+        bool bLoaded = false;
+        ULevelStreamingDynamic::LoadLevelInstance(World, MapPath, FVector::ZeroVector, FRotator::ZeroRotator, bLoaded,
+            FString::Printf(TEXT("%s_Sim%d"), *MapPath, Index));
+        if (!bLoaded)
+        {
+            World->RemoveFromRoot();
+            World->DestroyWorld(false);
+            return nullptr;
+        }
+
+        World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+        return World;
+    }
+
+    static void BeginPlay(FSimWorld& Sim, UClass* PawnClass)
+    {
+        UWorld* World = Sim.World;
+
+        for (TActorIterator<ATargetSpawner> It(World); It; ++It)
+        {
+            It->SetRandomSeed(Sim.Seed);
+            if (Sim.SpawnInterval > 0.f)
+            {
+                It->SetSpawnInterval(Sim.SpawnInterval);
+            }
+        }
+
+        // Subsystems first, then every actor in every level
+        World->BeginPlay();
+        World->GetWorldSettings()->NotifyBeginPlay();
+
+        TActorIterator<AGameManager> GameManagerIt(World);
+        Sim.GameManager = GameManagerIt ? *GameManagerIt : nullptr;
+
+        TActorIterator<APlayerStart> StartIt(World);
+        const FTransform Start = StartIt ? StartIt->GetActorTransform() : FTransform::Identity;
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        APlayerPawnBoomerang* Pawn = World->SpawnActor<APlayerPawnBoomerang>(PawnClass, Start, SpawnParams);
+        ABoomerangBotController* Bot = World->SpawnActor<ABoomerangBotController>(SpawnParams);
+        if (Pawn && Bot)
+        {
+            Bot->SetRandomSeed(Sim.Seed);
+            Bot->Possess(Pawn);
+        }
+    }
+}
+
+
+int32 USimBatchCommandlet::Main(const FString& Params)
+{
+    using namespace SimBatch;
+
+    FString MapPath = TEXT("/Game/Level");
+    int32 NumWorlds = 32;
+    int32 NumSessions = 4;
+    float Step = 1.f / 60.f;
+    int32 Seed = 1;
+    float SpawnInterval = 0.f;      // 0 keeps the map's interval
+    float SpawnIntervalMax = 0.f;   // spread intervals across worlds when set
+    FParse::Value(*Params, TEXT("map="), MapPath);
+    FParse::Value(*Params, TEXT("worlds="), NumWorlds);
+    FParse::Value(*Params, TEXT("sessions="), NumSessions);
+    FParse::Value(*Params, TEXT("step="), Step);
+    FParse::Value(*Params, TEXT("seed="), Seed);
+    FParse::Value(*Params, TEXT("spawninterval="), SpawnInterval);
+    FParse::Value(*Params, TEXT("spawnintervalmax="), SpawnIntervalMax);
+    NumWorlds = FMath::Max(NumWorlds, 1);
+    NumSessions = FMath::Max(NumSessions, 1);
+    Step = FMath::Clamp(Step, 0.001f, 0.1f);
+
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("SimBatch") /
+        FString::Printf(TEXT("SimBatch_%s.csv"), *FDateTime::Now().ToString());
+    FParse::Value(*Params, TEXT("output="), OutputPath);
+
+    FString PawnPath = TEXT("/Game/Blueprints/MyPlayerPawnBoomerang.MyPlayerPawnBoomerang_C");
+    FParse::Value(*Params, TEXT("pawn="), PawnPath);
+    UClass* PawnClass = LoadObject<UClass>(nullptr, *PawnPath);
+    if (!PawnClass || !PawnClass->IsChildOf<APlayerPawnBoomerang>())
+    {
+        UE_LOG(LogBoomerang, Error, TEXT("SimBatch: %s is not a APlayerPawnBoomerang class"), *PawnPath);
+        return 1;
+    }
+
+    const double SetupStart = FPlatformTime::Seconds();
+
+    TArray<FSimWorld> Sims;
+    Sims.Reserve(NumWorlds);
+    for (int32 i = 0; i < NumWorlds; ++i)
+    {
+        FSimWorld Sim;
+        Sim.World = CreateSimWorld(MapPath, i);
+        if (!Sim.World)
+        {
+            UE_LOG(LogBoomerang, Error, TEXT("SimBatch: failed to load %s"), *MapPath);
+            return 1;
+        }
+
+        Sim.Seed = Seed * 1000 + i + 1;
+        Sim.SpawnInterval = SpawnIntervalMax > SpawnInterval && NumWorlds > 1
+            ? FMath::Lerp(SpawnInterval, SpawnIntervalMax, static_cast<float>(i) / (NumWorlds - 1))
+            : SpawnInterval;
+
+        BeginPlay(Sim, PawnClass);
+        if (!Sim.GameManager)
+        {
+            UE_LOG(LogBoomerang, Error, TEXT("SimBatch: %s has no AGameManager"), *MapPath);
+            return 1;
+        }
+
+        Sims.Add(Sim);
+    }
+
+    UE_LOG(LogBoomerang, Display, TEXT("SimBatch: %d worlds of %s ready in %.2fs"), NumWorlds, *MapPath, FPlatformTime::Seconds() - SetupStart);
+
+    TArray<FString> Lines;
+    Lines.Add(TEXT("World,Session,Seed,SpawnInterval,Score,Throws,Hits,Duration"));
+
+    const double SimStart = FPlatformTime::Seconds();
+    int64 Steps = 0;
+    int32 NumActive = Sims.Num();
+
+    while (NumActive > 0)
+    {
+        for (int32 i = 0; i < Sims.Num(); ++i)
+        {
+            FSimWorld& Sim = Sims[i];
+            if (Sim.SessionsDone >= NumSessions) continue;
+
+            Sim.World->Tick(LEVELTICK_All, Step);
+
+            if (!Sim.GameManager->IsGameEnded()) continue;
+
+            Lines.Add(FString::Printf(TEXT("%d,%d,%d,%.3f,%d,%d,%d,%.1f"), i, Sim.SessionsDone, Sim.Seed, Sim.SpawnInterval,
+                Sim.GameManager->Score, Sim.GameManager->Throws, Sim.GameManager->Hits, Sim.GameManager->GetSessionDuration()));
+
+            if (++Sim.SessionsDone < NumSessions)
+            {
+                // No game instance to reload the level in, so always in place
+                Sim.GameManager->SoftRestart();
+            }
+            else
+            {
+                NumActive--;
+            }
+        }
+
+        // What the engine loop would do between frames
+        FTSTicker::GetCoreTicker().Tick(Step);
+        GFrameCounter++;
+
+        if (++Steps % GCInterval == 0)
+        {
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    const double SimSeconds = FPlatformTime::Seconds() - SimStart;
+    const double WorldSeconds = Steps * Step * NumWorlds;
+
+    for (FSimWorld& Sim : Sims)
+    {
+        Sim.World->RemoveFromRoot();
+        Sim.World->DestroyWorld(false);
+    }
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+    {
+        UE_LOG(LogBoomerang, Error, TEXT("SimBatch: failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogBoomerang, Display, TEXT("SimBatch: %d sessions in %.2fs (%.0fx real time), results in %s"),
+        Lines.Num() - 1, SimSeconds, WorldSeconds / FMath::Max(SimSeconds, 0.001), *OutputPath);
+    return 0;
+}
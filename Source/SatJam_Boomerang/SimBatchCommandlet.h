@@ -0,0 +1,23 @@
+// SimBatchCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SimBatchCommandlet.generated.h"
+
+// Runs many independent game worlds in one process, each with its own copy of the map and a bot
+// throwing, ticked at a fixed step with no rendering. Each finished session is one row in the output.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=SimBatch -nullrhi [-map=/Game/Level] [-worlds=32]
+//     [-sessions=4] [-step=0.0166667] [-seed=1] [-spawninterval=1.0] [-spawnintervalmax=3.0]
+//     [-pawn=/Game/Blueprints/MyPlayerPawnBoomerang.MyPlayerPawnBoomerang_C] [-output=Saved/SimBatch/Results.csv]
+UCLASS()
+class SATJAM_BOOMERANG_API USimBatchCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    USimBatchCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,364 @@
+// SoakTestSubsystem.cpp
+
+#include "SoakTestSubsystem.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangActor.h"
+#include "BoomerangBotController.h"
+#include "BoomerangTarget.h"
+#include "GameManager.h"
+#include "GCChurnMonitor.h"
+#include "BoomerangStats.h"
+#include "PlayerPawnBoomerang.h"
+#include "TargetSpawner.h"
+#include "EngineUtils.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "CoreGlobals.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(BoomerangSoak, true);
+
+
+bool USoakTestSubsystem::IsSoakRun()
+{
+    return FParse::Param(FCommandLine::Get(), TEXT("soak"));
+}
+
+
+bool USoakTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return IsSoakRun() && Super::ShouldCreateSubsystem(Outer);
+}
+
+
+bool USoakTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void USoakTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    float Minutes = DurationSeconds / 60.f;
+    FParse::Value(FCommandLine::Get(), TEXT("soakminutes="), Minutes);
+    FParse::Value(FCommandLine::Get(), TEXT("soakspawninterval="), SpawnInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("soakthrowinterval="), ThrowInterval);
+    FParse::Value(FCommandLine::Get(), TEXT("soakhitchms="), HitchThresholdMs);
+    FParse::Value(FCommandLine::Get(), TEXT("soakbots="), NumBots);
+    bKeepMapSpawnRate = FParse::Param(FCommandLine::Get(), TEXT("soakkeepspawnrate"));
+    DurationSeconds = FMath::Max(Minutes, 0.1f) * 60.f;
+
+    int32 Seed = 1337;
+    FParse::Value(FCommandLine::Get(), TEXT("soakseed="), Seed);
+    AimStream.Initialize(Seed);
+
+    // Roughly one sample per frame at 60 fps
+    FrameTimesMs.Reserve(FMath::CeilToInt(DurationSeconds * 60.f));
+    GameThreadTimesMs.Reserve(FMath::CeilToInt(DurationSeconds * 60.f));
+    SweepTimesMs.Reserve(FMath::CeilToInt(DurationSeconds * 60.f));
+    OverlapTimesMs.Reserve(FMath::CeilToInt(DurationSeconds * 60.f));
+
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &USoakTestSubsystem::OnEndFrame);
+}
+
+
+void USoakTestSubsystem::Deinitialize()
+{
+    // Early quit still produces a summary
+    if (bStarted && !bSummaryWritten)
+    {
+        WriteSummary();
+    }
+
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+
+    Super::Deinitialize();
+}
+
+
+void USoakTestSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USoakTestSubsystem::OnActorSpawned));
+    ActorDestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &USoakTestSubsystem::OnActorDestroyed));
+
+    // Force a high spawn rate on every spawner
+    for (TActorIterator<ATargetSpawner> It(&InWorld); It; ++It)
+    {
+        NumSpawners++;
+
+        if (!bKeepMapSpawnRate)
+        {
+            It->SetSpawnInterval(SpawnInterval);
+        }
+    }
+
+    for (TActorIterator<AStaticMeshActor> It(&InWorld); It; ++It)
+    {
+        NumStaticMeshActors++;
+    }
+
+    FBoomerangFrameCost::Reset();
+
+#if CSV_PROFILER
+    FCsvProfiler::Get()->BeginCapture();
+#endif
+
+    StartTime = FPlatformTime::Seconds();
+    bStarted = true;
+
+    UE_LOG(LogBoomerang, Display, TEXT("Soak test started: %.1f minutes, spawn interval %.2fs, throw interval %.2fs"),
+        DurationSeconds / 60.f, SpawnInterval, ThrowInterval);
+}
+
+
+void USoakTestSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!bStarted || bSummaryWritten) return;
+
+    const float FrameMs = DeltaTime * 1000.f;
+    FrameTimesMs.Add(FrameMs);
+    GameThreadTimesMs.Add(LastGameThreadMs);
+
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, MemoryStats.UsedPhysical);
+
+    const float SweepMs = FBoomerangFrameCost::GetMs(EBoomerangFrameCost::Sweep);
+    const float OverlapMs = FBoomerangFrameCost::GetMs(EBoomerangFrameCost::Overlap);
+    SweepTimesMs.Add(SweepMs);
+    OverlapTimesMs.Add(OverlapMs);
+    NumSweeps += FBoomerangFrameCost::Calls[(int32)EBoomerangFrameCost::Sweep];
+    NumOverlaps += FBoomerangFrameCost::Calls[(int32)EBoomerangFrameCost::Overlap];
+    FBoomerangFrameCost::Reset();
+
+    CSV_CUSTOM_STAT(BoomerangSoak, FrameMs, FrameMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, SweepMs, SweepMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, OverlapMs, OverlapMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, GameThreadMs, LastGameThreadMs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, LiveTargets, LiveTargets, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, LiveBoomerangs, LiveBoomerangs, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, TargetsSpawned, static_cast<int32>(TargetsSpawned), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, TargetsDestroyed, static_cast<int32>(TargetsDestroyed), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSoak, UsedPhysicalMB, static_cast<float>(MemoryStats.UsedPhysical / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+
+    // Keep the session going for the whole run
+    AGameManager* GameManager = Cast<AGameManager>(
+        UGameplayStatics::GetActorOfClass(GetWorld(), AGameManager::StaticClass())
+    );
+
+    if (GameManager && GameManager->IsGameEnded())
+    {
+        GameManager->RestartGame();
+    }
+
+    if (!bBotsSpawned)
+    {
+        SpawnBots();
+    }
+
+    TimeSinceThrow += DeltaTime;
+    if (TimeSinceThrow >= ThrowInterval)
+    {
+        TimeSinceThrow = 0.f;
+        ScriptedThrow();
+    }
+
+    if (FPlatformTime::Seconds() - StartTime >= DurationSeconds)
+    {
+        WriteSummary();
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+
+TStatId USoakTestSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USoakTestSubsystem, STATGROUP_Tickables);
+}
+
+
+void USoakTestSubsystem::ScriptedThrow()
+{
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    APlayerPawnBoomerang* PlayerPawn = PC ? Cast<APlayerPawnBoomerang>(PC->GetPawn()) : nullptr;
+    if (!PlayerPawn || PlayerPawn->HasActiveBoomerang()) return;
+
+    PlayerPawn->SetAimRotation(FRotator(AimStream.FRandRange(-10.f, 45.f), AimStream.FRandRange(0.f, 360.f), 0.f));
+    PlayerPawn->ThrowBoomerang();
+}
+
+
+void USoakTestSubsystem::SpawnBots()
+{
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    APawn* PlayerPawn = PC ? PC->GetPawn() : nullptr;
+    if (!PlayerPawn) return;
+
+    bBotsSpawned = true;
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Ring of bots around the player, same pawn class so they throw the same boomerang
+    for (int32 i = 0; i < NumBots; ++i)
+    {
+        const float Angle = 2.f * PI * i / NumBots;
+        const FVector Location = PlayerPawn->GetActorLocation() + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * 200.f;
+
+        APlayerPawnBoomerang* BotPawn = GetWorld()->SpawnActor<APlayerPawnBoomerang>(PlayerPawn->GetClass(), Location, FRotator::ZeroRotator, SpawnParams);
+        ABoomerangBotController* Bot = GetWorld()->SpawnActor<ABoomerangBotController>(SpawnParams);
+
+        if (BotPawn && Bot)
+        {
+            Bot->Possess(BotPawn);
+        }
+    }
+
+    UE_LOG(LogBoomerang, Display, TEXT("Soak test spawned %d bots"), NumBots);
+}
+
+
+void USoakTestSubsystem::OnActorSpawned(AActor* Actor)
+{
+    if (Actor->IsA<ABoomerangTarget>())
+    {
+        TargetsSpawned++;
+        PeakTargets = FMath::Max(PeakTargets, ++LiveTargets);
+    }
+    else if (Actor->IsA<ABoomerangActor>())
+    {
+        BoomerangsSpawned++;
+        PeakBoomerangs = FMath::Max(PeakBoomerangs, ++LiveBoomerangs);
+    }
+}
+
+
+void USoakTestSubsystem::OnActorDestroyed(AActor* Actor)
+{
+    if (Actor->IsA<ABoomerangTarget>())
+    {
+        TargetsDestroyed++;
+        LiveTargets--;
+    }
+    else if (Actor->IsA<ABoomerangActor>())
+    {
+        BoomerangsDestroyed++;
+        LiveBoomerangs--;
+    }
+}
+
+
+void USoakTestSubsystem::OnEndFrame()
+{
+    // Used on the next tick, this frame's work isn't finished yet when we tick.
+    // Same source as the frame budget governor, so the report and the governor agree.
+    LastGameThreadMs = static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime));
+}
+
+
+// Value at the given percentile (0-100) of an already sorted array
+static float SortedPercentile(const TArray<float>& Sorted, float Percentile)
+{
+    if (Sorted.Num() == 0) return 0.f;
+
+    const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile / 100.f * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+    return Sorted[Index];
+}
+
+
+void USoakTestSubsystem::WriteSummary()
+{
+    bSummaryWritten = true;
+
+#if CSV_PROFILER
+    FCsvProfiler::Get()->EndCapture();
+#endif
+
+    TArray<float> SortedFrames = FrameTimesMs;
+    SortedFrames.Sort();
+    TArray<float> SortedGameThread = GameThreadTimesMs;
+    SortedGameThread.Sort();
+    TArray<float> SortedSweep = SweepTimesMs;
+    SortedSweep.Sort();
+    TArray<float> SortedOverlap = OverlapTimesMs;
+    SortedOverlap.Sort();
+    const int32 NumFrames = FMath::Max(FrameTimesMs.Num(), 1);
+
+    int32 HitchCount = 0;
+    for (float FrameMs : FrameTimesMs)
+    {
+        if (FrameMs > HitchThresholdMs)
+        {
+            HitchCount++;
+        }
+    }
+
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Metric,Value"));
+    Lines.Add(FString::Printf(TEXT("Map,%s"), *GetWorld()->GetMapName()));
+    Lines.Add(FString::Printf(TEXT("Spawners,%d"), NumSpawners));
+    Lines.Add(FString::Printf(TEXT("StaticMeshActors,%d"), NumStaticMeshActors));
+    Lines.Add(FString::Printf(TEXT("DurationSeconds,%.1f"), FPlatformTime::Seconds() - StartTime));
+    Lines.Add(FString::Printf(TEXT("Frames,%d"), FrameTimesMs.Num()));
+    Lines.Add(FString::Printf(TEXT("FrameMsP50,%.3f"), SortedPercentile(SortedFrames, 50.f)));
+    Lines.Add(FString::Printf(TEXT("FrameMsP95,%.3f"), SortedPercentile(SortedFrames, 95.f)));
+    Lines.Add(FString::Printf(TEXT("FrameMsP99,%.3f"), SortedPercentile(SortedFrames, 99.f)));
+    Lines.Add(FString::Printf(TEXT("FrameMsMax,%.3f"), SortedFrames.Num() > 0 ? SortedFrames.Last() : 0.f));
+    Lines.Add(FString::Printf(TEXT("GameThreadMsP50,%.3f"), SortedPercentile(SortedGameThread, 50.f)));
+    Lines.Add(FString::Printf(TEXT("GameThreadMsP95,%.3f"), SortedPercentile(SortedGameThread, 95.f)));
+    Lines.Add(FString::Printf(TEXT("GameThreadMsP99,%.3f"), SortedPercentile(SortedGameThread, 99.f)));
+    Lines.Add(FString::Printf(TEXT("SweepMsP50,%.3f"), SortedPercentile(SortedSweep, 50.f)));
+    Lines.Add(FString::Printf(TEXT("SweepMsP95,%.3f"), SortedPercentile(SortedSweep, 95.f)));
+    Lines.Add(FString::Printf(TEXT("SweepMsP99,%.3f"), SortedPercentile(SortedSweep, 99.f)));
+    Lines.Add(FString::Printf(TEXT("SweepsPerFrame,%.2f"), static_cast<double>(NumSweeps) / NumFrames));
+    Lines.Add(FString::Printf(TEXT("OverlapMsP50,%.3f"), SortedPercentile(SortedOverlap, 50.f)));
+    Lines.Add(FString::Printf(TEXT("OverlapMsP95,%.3f"), SortedPercentile(SortedOverlap, 95.f)));
+    Lines.Add(FString::Printf(TEXT("OverlapMsP99,%.3f"), SortedPercentile(SortedOverlap, 99.f)));
+    Lines.Add(FString::Printf(TEXT("OverlapsPerFrame,%.2f"), static_cast<double>(NumOverlaps) / NumFrames));
+    Lines.Add(FString::Printf(TEXT("HitchThresholdMs,%.1f"), HitchThresholdMs));
+    Lines.Add(FString::Printf(TEXT("HitchCount,%d"), HitchCount));
+    Lines.Add(FString::Printf(TEXT("PeakTargets,%d"), PeakTargets));
+    Lines.Add(FString::Printf(TEXT("PeakBoomerangs,%d"), PeakBoomerangs));
+    Lines.Add(FString::Printf(TEXT("TargetsSpawned,%lld"), TargetsSpawned));
+    Lines.Add(FString::Printf(TEXT("TargetsDestroyed,%lld"), TargetsDestroyed));
+    Lines.Add(FString::Printf(TEXT("BoomerangsSpawned,%lld"), BoomerangsSpawned));
+    Lines.Add(FString::Printf(TEXT("BoomerangsDestroyed,%lld"), BoomerangsDestroyed));
+    Lines.Add(FString::Printf(TEXT("PeakUsedPhysicalMB,%.1f"), PeakUsedPhysical / (1024.0 * 1024.0)));
+
+    FGCChurnMonitor::AppendSummary(Lines);
+
+    FString SummaryPath = FPaths::ProfilingDir() / TEXT("Soak") /
+        FString::Printf(TEXT("SoakSummary_%s.csv"), *FDateTime::Now().ToString());
+    FParse::Value(FCommandLine::Get(), TEXT("soaksummary="), SummaryPath);
+
+    if (FFileHelper::SaveStringArrayToFile(Lines, *SummaryPath))
+    {
+        UE_LOG(LogBoomerang, Display, TEXT("Soak summary written to %s"), *SummaryPath);
+    }
+    else
+    {
+        UE_LOG(LogBoomerang, Error, TEXT("Failed to write soak summary to %s"), *SummaryPath);
+    }
+
+    for (const FString& Line : Lines)
+    {
+        UE_LOG(LogBoomerang, Display, TEXT("  %s"), *Line);
+    }
+}
@@ -0,0 +1,92 @@
+// SoakTestSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SoakTestSubsystem.generated.h"
+
+// Headless load test, enabled with -soak.
+// Example: SatJam_Boomerang Level -game -nullrhi -soak -soakminutes=10 -soakspawninterval=0.1 -soakbots=24
+// Add -soakkeepspawnrate to keep the map's own spawner settings (generated stress maps),
+// and -soaksummary=<path> to choose where the summary goes.
+// Scripted throws run against a forced spawn rate, per-frame stats go to the CSV profiler,
+// and a frame time summary is written to Saved/Profiling/Soak when the run ends.
+UCLASS()
+class SATJAM_BOOMERANG_API USoakTestSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    static bool IsSoakRun();
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void OnActorSpawned(AActor* Actor);
+    void OnActorDestroyed(AActor* Actor);
+    void OnEndFrame();
+
+    // Aim somewhere random and throw if the pawn is ready
+    void ScriptedThrow();
+
+    // Spawns extra pawns driven by ABoomerangBotController next to the player
+    void SpawnBots();
+
+    void WriteSummary();
+
+    // Settings from the command line
+    float DurationSeconds = 600.f;
+    float SpawnInterval = 0.1f;
+    float ThrowInterval = 0.5f;
+    float HitchThresholdMs = 50.f;
+    int32 NumBots = 0;
+    bool bKeepMapSpawnRate = false;
+
+    bool bStarted = false;
+    bool bBotsSpawned = false;
+    bool bSummaryWritten = false;
+    double StartTime = 0.0;
+    float TimeSinceThrow = 0.f;
+
+    FRandomStream AimStream;
+
+    // Per-frame samples in milliseconds
+    TArray<float> FrameTimesMs;
+    TArray<float> GameThreadTimesMs;
+    TArray<float> SweepTimesMs;
+    TArray<float> OverlapTimesMs;
+    int64 NumSweeps = 0;
+    int64 NumOverlaps = 0;
+
+    // Map size, so stress runs can be compared against geometry and spawner count
+    int32 NumSpawners = 0;
+    int32 NumStaticMeshActors = 0;
+
+    // Game-thread work of the last finished frame, vsync and frame-rate limiter waits excluded
+    float LastGameThreadMs = 0.f;
+
+    // Live counts and totals since the run started
+    int32 LiveTargets = 0;
+    int32 LiveBoomerangs = 0;
+    int32 PeakTargets = 0;
+    int32 PeakBoomerangs = 0;
+    int64 TargetsSpawned = 0;
+    int64 TargetsDestroyed = 0;
+    int64 BoomerangsSpawned = 0;
+    int64 BoomerangsDestroyed = 0;
+    uint64 PeakUsedPhysical = 0;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FDelegateHandle EndFrameHandle;
+};
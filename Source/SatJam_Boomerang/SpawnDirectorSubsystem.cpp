@@ -0,0 +1,230 @@
+// SpawnDirectorSubsystem.cpp
+
+#include "SpawnDirectorSubsystem.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangSettings.h"
+#include "TargetSpawner.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(BoomerangSpawn, true);
+
+
+bool USpawnDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void USpawnDirectorSubsystem::RegisterSpawner(ATargetSpawner* Spawner)
+{
+    if (!Spawner || FindState(Spawner)) return;
+
+    FSpawnerState& State = Spawners.AddDefaulted_GetRef();
+    State.Spawner = Spawner;
+    Spawner->SetSpawnRateScale(SpawnRateScale);
+
+    UpdateShares();
+}
+
+
+void USpawnDirectorSubsystem::UnregisterSpawner(ATargetSpawner* Spawner)
+{
+    const int32 Index = Spawners.IndexOfByPredicate([Spawner](const FSpawnerState& State) { return State.Spawner.Get() == Spawner; });
+    if (Index == INDEX_NONE) return;
+
+    // Its targets stay in the world until they expire, keep counting them
+    Spawners.RemoveAt(Index);
+    UpdateShares();
+}
+
+
+USpawnDirectorSubsystem::FSpawnerState* USpawnDirectorSubsystem::FindState(const ATargetSpawner* Spawner)
+{
+    return Spawners.FindByPredicate([Spawner](const FSpawnerState& State) { return State.Spawner.Get() == Spawner; });
+}
+
+
+ATargetSpawner* USpawnDirectorSubsystem::GetPrimarySpawner() const
+{
+    for (const FSpawnerState& State : Spawners)
+    {
+        if (ATargetSpawner* Spawner = State.Spawner.Get())
+        {
+            return Spawner;
+        }
+    }
+    return nullptr;
+}
+
+
+bool USpawnDirectorSubsystem::TryAcquireSpawn(ATargetSpawner* Spawner)
+{
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+
+    const bool bOverLiveCap = Settings->MaxLiveTargets > 0 && NumLiveTargets >= Settings->MaxLiveTargets;
+    const bool bOverFrameCap = Settings->MaxSpawnsPerFrame > 0 && NumSpawnsThisFrame >= Settings->MaxSpawnsPerFrame;
+
+    FSpawnerState* State = FindState(Spawner);
+    const bool bOverQuota = State && Settings->MaxSpawnsPerSecond > 0.f && State->Credit < 1.f;
+
+    if (bOverLiveCap || bOverFrameCap || bOverQuota)
+    {
+        NumDeniedThisFrame++;
+        return false;
+    }
+
+    if (State && Settings->MaxSpawnsPerSecond > 0.f)
+    {
+        State->Credit -= 1.f;
+    }
+    NumSpawnsThisFrame++;
+    return true;
+}
+
+
+void USpawnDirectorSubsystem::NotifyTargetSpawned(ATargetSpawner* Spawner)
+{
+    NumLiveTargets++;
+    NumTargetsSpawned++;
+
+    if (FSpawnerState* State = FindState(Spawner))
+    {
+        State->NumLive++;
+    }
+}
+
+
+void USpawnDirectorSubsystem::NotifyTargetRemoved(ATargetSpawner* Spawner)
+{
+    NumLiveTargets = FMath::Max(NumLiveTargets - 1, 0);
+
+    if (FSpawnerState* State = FindState(Spawner))
+    {
+        State->NumLive = FMath::Max(State->NumLive - 1, 0);
+    }
+}
+
+
+void USpawnDirectorSubsystem::StopAll()
+{
+    for (const FSpawnerState& State : Spawners)
+    {
+        if (ATargetSpawner* Spawner = State.Spawner.Get())
+        {
+            Spawner->StopSpawning();
+        }
+    }
+
+    UE_LOG(LogBoomerang, Log, TEXT("Spawn director: stopped %d spawner(s)."), Spawners.Num());
+}
+
+
+void USpawnDirectorSubsystem::StartAll()
+{
+    for (FSpawnerState& State : Spawners)
+    {
+        if (ATargetSpawner* Spawner = State.Spawner.Get())
+        {
+            State.Credit = 1.f;
+            Spawner->StartSpawning();
+        }
+    }
+
+    UE_LOG(LogBoomerang, Log, TEXT("Spawn director: started %d spawner(s)."), Spawners.Num());
+}
+
+
+void USpawnDirectorSubsystem::SetSpawnRateScale(float NewScale)
+{
+    SpawnRateScale = FMath::Clamp(NewScale, 0.01f, 1.f);
+
+    for (const FSpawnerState& State : Spawners)
+    {
+        if (ATargetSpawner* Spawner = State.Spawner.Get())
+        {
+            Spawner->SetSpawnRateScale(SpawnRateScale);
+        }
+    }
+}
+
+
+void USpawnDirectorSubsystem::UpdateShares()
+{
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+
+    // Players to measure proximity against
+    TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+    if (Settings->SpawnQuotaMode == ESpawnQuotaMode::WeightAndProximity)
+    {
+        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+        {
+            if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+            {
+                PlayerLocations.Add(Pawn->GetActorLocation());
+            }
+        }
+    }
+
+    float TotalWeight = 0.f;
+    for (FSpawnerState& State : Spawners)
+    {
+        const ATargetSpawner* Spawner = State.Spawner.Get();
+        State.Share = Spawner ? Spawner->GetSpawnWeight() : 0.f;
+
+        if (Spawner && PlayerLocations.Num() > 0)
+        {
+            double NearestSq = TNumericLimits<double>::Max();
+            for (const FVector& Location : PlayerLocations)
+            {
+                NearestSq = FMath::Min(NearestSq, FVector::DistSquared(Location, Spawner->GetActorLocation()));
+            }
+
+            // Full weight next to a player, half at the falloff distance
+            State.Share /= 1.f + static_cast<float>(FMath::Sqrt(NearestSq)) / Settings->SpawnProximityFalloff;
+        }
+
+        TotalWeight += State.Share;
+    }
+
+    for (FSpawnerState& State : Spawners)
+    {
+        State.Share = TotalWeight > 0.f ? State.Share / TotalWeight : 0.f;
+    }
+}
+
+
+void USpawnDirectorSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    CSV_CUSTOM_STAT(BoomerangSpawn, LiveTargets, NumLiveTargets, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSpawn, Spawns, NumSpawnsThisFrame, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(BoomerangSpawn, SpawnsDenied, NumDeniedThisFrame, ECsvCustomStatOp::Set);
+
+    NumSpawnsThisFrame = 0;
+    NumDeniedThisFrame = 0;
+
+    Spawners.RemoveAll([](const FSpawnerState& State) { return !State.Spawner.IsValid(); });
+
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    if (Settings->SpawnQuotaMode == ESpawnQuotaMode::WeightAndProximity)
+    {
+        UpdateShares();
+    }
+
+    // Refill each spawner's credit at its share of the global rate, one spawn of burst at most
+    const float Rate = Settings->MaxSpawnsPerSecond * SpawnRateScale;
+    for (FSpawnerState& State : Spawners)
+    {
+        State.Credit = FMath::Min(State.Credit + DeltaTime * Rate * State.Share, 1.f);
+    }
+}
+
+
+TStatId USpawnDirectorSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USpawnDirectorSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,76 @@
+// SpawnDirectorSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpawnDirectorSubsystem.generated.h"
+
+class ATargetSpawner;
+
+// Every ATargetSpawner registers here. Spawners still run their own timers, but each spawn
+// has to be granted: the director enforces the global live-target cap, the per-frame cap and
+// the global spawn rate, split between spawners by weight (and optionally player proximity).
+UCLASS()
+class SATJAM_BOOMERANG_API USpawnDirectorSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void RegisterSpawner(ATargetSpawner* Spawner);
+    void UnregisterSpawner(ATargetSpawner* Spawner);
+
+    // Server only, called when a spawner's timer fires. False means skip this spawn.
+    bool TryAcquireSpawn(ATargetSpawner* Spawner);
+
+    void NotifyTargetSpawned(ATargetSpawner* Spawner);
+    void NotifyTargetRemoved(ATargetSpawner* Spawner);
+
+    // Stops or (re)starts every registered spawner
+    void StopAll();
+    void StartAll();
+
+    // Applied to every spawner's own rate and to the global rate
+    void SetSpawnRateScale(float NewScale);
+
+    int32 GetNumLiveTargets() const { return NumLiveTargets; }
+
+    // Total targets spawned in this world, changes whenever a target is added
+    uint32 GetNumTargetsSpawned() const { return NumTargetsSpawned; }
+
+    // First registered spawner, for callers that only need one (e.g. the session seed)
+    ATargetSpawner* GetPrimarySpawner() const;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FSpawnerState
+    {
+        TWeakObjectPtr<ATargetSpawner> Spawner;
+
+        // Fraction of the global rate this spawner gets
+        float Share = 0.f;
+
+        // Spawns available now, refilled at its share of the global rate
+        float Credit = 1.f;
+
+        int32 NumLive = 0;
+    };
+
+    FSpawnerState* FindState(const ATargetSpawner* Spawner);
+
+    // Recomputes every spawner's share from weight and distance to the nearest player
+    void UpdateShares();
+
+    TArray<FSpawnerState> Spawners;
+
+    int32 NumLiveTargets = 0;
+    uint32 NumTargetsSpawned = 0;
+    int32 NumSpawnsThisFrame = 0;
+    int32 NumDeniedThisFrame = 0;
+    float SpawnRateScale = 1.f;
+};
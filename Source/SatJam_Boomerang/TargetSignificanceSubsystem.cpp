@@ -0,0 +1,135 @@
+// TargetSignificanceSubsystem.cpp
+
+#include "TargetSignificanceSubsystem.h"
+#include "BoomerangSettings.h"
+#include "BoomerangTarget.h"
+#include "BoomerangActor.h"
+#include "PlayerPawnBoomerang.h"
+#include "SignificanceManager.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+
+static const FName TargetSignificanceTag(TEXT("BoomerangTarget"));
+
+
+bool UTargetSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+
+void UTargetSignificanceSubsystem::RegisterTarget(ABoomerangTarget* Target)
+{
+    if (!GetDefault<UBoomerangSettings>()->bEnableTargetSignificance) return;
+
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if (!SignificanceManager) return;
+
+    SignificanceManager->RegisterObject(Target, TargetSignificanceTag,
+        [this](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+        {
+            return CalculateSignificance(CastChecked<ABoomerangTarget>(Info->GetObject()), Viewpoint);
+        },
+        USignificanceManager::EPostSignificanceType::Sequential,
+        [](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float Significance, bool bFinal)
+        {
+            CastChecked<ABoomerangTarget>(Info->GetObject())->ApplySignificance(Significance);
+        });
+}
+
+
+void UTargetSignificanceSubsystem::UnregisterTarget(ABoomerangTarget* Target)
+{
+    if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+    {
+        SignificanceManager->UnregisterObject(Target);
+    }
+}
+
+
+void UTargetSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if (!SignificanceManager || !GetDefault<UBoomerangSettings>()->bEnableTargetSignificance) return;
+
+    Viewpoints.Reset();
+    ThrowerReach.Reset();
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (const APlayerController* PC = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            Viewpoints.Add(FTransform(ViewRotation, ViewLocation));
+        }
+    }
+
+    // Bots throw too, so every boomerang pawn counts as a thrower.
+    // The sphere is conservative: pitch is clamped, so some of it can't actually be reached.
+    for (TActorIterator<APlayerPawnBoomerang> It(GetWorld()); It; ++It)
+    {
+        const FBoomerangThrowDescriptor Shape = It->MakeThrowDescriptor(FRotator::ZeroRotator);
+
+        float SweepRadius = 0.f;
+        if (TSubclassOf<ABoomerangActor> BoomerangClass = It->GetBoomerangClass())
+        {
+            SweepRadius = BoomerangClass->GetDefaultObject<ABoomerangActor>()->GetSweepRadius();
+        }
+
+        const float Reach = Shape.GetMaxRadius() + SweepRadius;
+        ThrowerReach.Add(FSphere(It->GetActorLocation(), Reach));
+
+        // Dedicated servers have no player views of their own
+        if (GetWorld()->GetNetMode() == NM_DedicatedServer)
+        {
+            Viewpoints.Add(FTransform(It->GetAimRotation(), It->GetActorLocation()));
+        }
+    }
+
+    SignificanceManager->Update(Viewpoints);
+}
+
+
+float UTargetSignificanceSubsystem::CalculateSignificance(const ABoomerangTarget* Target, const FTransform& Viewpoint) const
+{
+    const UBoomerangSettings* Settings = GetDefault<UBoomerangSettings>();
+    const FVector Location = Target->GetActorLocation();
+
+    if (!IsReachable(Location)) return 0.f;
+
+    const FVector ToTarget = Location - Viewpoint.GetLocation();
+    const float Distance = static_cast<float>(ToTarget.Size());
+    const float DistanceScore = 1.f - FMath::Clamp(Distance / Settings->TargetSignificanceDistance, 0.f, 1.f);
+
+    // Off-screen targets still matter a little, the player can turn to them
+    const float Facing = static_cast<float>(FVector::DotProduct(Viewpoint.GetRotation().GetForwardVector(), ToTarget.GetSafeNormal()));
+    const float ViewScore = Facing >= FMath::Cos(FMath::DegreesToRadians(Settings->TargetViewHalfAngle)) ? 1.f : 0.25f;
+
+    // Anything reachable stays above 0, 0 means overlaps can be switched off
+    return FMath::Max(DistanceScore * ViewScore, UE_KINDA_SMALL_NUMBER);
+}
+
+
+bool UTargetSignificanceSubsystem::IsReachable(const FVector& Location) const
+{
+    const float Margin = GetDefault<UBoomerangSettings>()->TargetReachMargin;
+
+    for (const FSphere& Reach : ThrowerReach)
+    {
+        if (FVector::DistSquared(Reach.Center, Location) <= FMath::Square(Reach.W + Margin))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+TStatId UTargetSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTargetSignificanceSubsystem, STATGROUP_Tickables);
+}
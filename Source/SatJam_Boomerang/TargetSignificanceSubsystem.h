@@ -0,0 +1,39 @@
+// TargetSignificanceSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TargetSignificanceSubsystem.generated.h"
+
+class ABoomerangTarget;
+
+// Registers targets with the significance manager and updates it every frame.
+// Targets are scored by distance and view angle from every player view, and score 0 when
+// no boomerang thrower can reach them. ABoomerangTarget::ApplySignificance turns that into
+// mesh LOD and overlap events.
+UCLASS()
+class SATJAM_BOOMERANG_API UTargetSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    void RegisterTarget(ABoomerangTarget* Target);
+    void UnregisterTarget(ABoomerangTarget* Target);
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    float CalculateSignificance(const ABoomerangTarget* Target, const FTransform& Viewpoint) const;
+
+    // True if any thrower's boomerang could get to Location
+    bool IsReachable(const FVector& Location) const;
+
+    // Gathered on the game thread before each update, read by the (possibly parallel) scoring
+    TArray<FTransform> Viewpoints;
+    TArray<FSphere> ThrowerReach;
+};
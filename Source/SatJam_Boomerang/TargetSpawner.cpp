@@ -2,7 +2,14 @@
 
 
 #include "TargetSpawner.h"
+#include "BoomerangStats.h"
+#include "BoomerangMemory.h"
+#include "SatJam_Boomerang.h"
+#include "BoomerangTelemetry.h"
 #include "BoomerangTarget.h"
+#include "BoomerangReachabilityGrid.h"
+#include "SpawnDirectorSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 // Sets default values
 ATargetSpawner::ATargetSpawner()
@@ -10,6 +17,19 @@ ATargetSpawner::ATargetSpawner()
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
+    // Only seed and slot replicate, targets are spawned locally on each machine
+    bReplicates = true;
+    bAlwaysRelevant = true;
+    SetReplicatingMovement(false);
+}
+
+
+void ATargetSpawner::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(ATargetSpawner, SpawnSeed);
+    DOREPLIFETIME(ATargetSpawner, SpawnSlot);
 }
 
 
@@ -18,12 +38,78 @@ void ATargetSpawner::BeginPlay()
 {
 	Super::BeginPlay();
 	
+    BuildReachableCells();
+
+    if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+    {
+        Director->RegisterSpawner(this);
+    }
+
+    StartSpawning();
+}
+
+
+void ATargetSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+    {
+        Director->UnregisterSpawner(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+
+void ATargetSpawner::BuildReachableCells()
+{
+    ReachableCells.Reset();
+    ReachableCellTable.Reset();
+
+    if (!ReachabilityGrid) return;
+
+    // Same filter on every machine, so slot positions still match across the network
+    TArray<float> Weights;
+    for (int32 i = 0; i < ReachabilityGrid->GetNumReachableCells(); ++i)
+    {
+        const float Probability = ReachabilityGrid->HitProbability[i];
+        if (Probability < MinHitProbability) continue;
+
+        const FVector FromSpawner = ThrowOrigin + ReachabilityGrid->GetCellCenter(i);
+        const float Radius = FromSpawner.Size2D();
+        if (Radius < MinSpawnRadius || Radius > MaxSpawnRadius) continue;
+        if (FromSpawner.Z < MinSpawnHeight || FromSpawner.Z > MaxSpawnHeight) continue;
+
+        ReachableCells.Add(i);
+        Weights.Add(Probability);
+    }
+
+    ReachableCellTable.Build(Weights);
+
+    if (ReachableCellTable.IsEmpty())
+    {
+        UE_LOG(LogBoomerang, Warning, TEXT("TargetSpawner: no cell of %s is reachable inside the spawn band, spawning anywhere in the band"), *ReachabilityGrid->GetName());
+    }
+    else
+    {
+        UE_LOG(LogBoomerang, Log, TEXT("TargetSpawner: %d of %d reachable cells are inside the spawn band"), ReachableCells.Num(), ReachabilityGrid->GetNumReachableCells());
+    }
+}
+
+
+void ATargetSpawner::StartSpawning()
+{
+    // Clients follow the server's replicated slots instead of running a timer
+    if (GetNetMode() == NM_Client) return;
+
+    SpawnSeed = RandomSeed != 0 ? RandomSeed : FMath::Rand();
+    SpawnSlot = 0;
+
     // Start a repeating timer that calls SpawnTarget() every few seconds
     GetWorldTimerManager().SetTimer(
         SpawnTimerHandle,
         this,
         &ATargetSpawner::SpawnTarget,
-        SpawnInterval,
+        GetEffectiveSpawnInterval(),
         true // loop
     );
 }
@@ -39,27 +125,58 @@ void ATargetSpawner::Tick(float DeltaTime)
 
 void ATargetSpawner::SpawnTarget()
 {
+    // The director may hold this spawn back to keep the level inside its global budget
+    USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>();
+    if (Director && !Director->TryAcquireSpawn(this)) return;
+
+    SpawnSlot++;
+    SpawnTargetForSlot(SpawnSlot);
+}
+
+
+void ATargetSpawner::SpawnTargetForSlot(int32 Slot)
+{
+    BOOMERANG_SCOPE_CYCLE_COUNTER(STAT_SpawnTarget);
+    LLM_SCOPE_BYTAG(Boomerang_Targets);
+
     // Safety check: Make sure we have a valid enemy class set
     if (!TargetClass)
     {
-        UE_LOG(LogTemp, Error, TEXT("TargetSpawner: TargetClass not set!"));
+        UE_LOG(LogBoomerang, Error, TEXT("TargetSpawner: TargetClass not set!"));
         return;
     }
 
+    // Each slot gets its own stream so any machine can compute it without the ones before
+    FRandomStream SlotStream(static_cast<int32>(HashCombine(GetTypeHash(SpawnSeed), GetTypeHash(Slot))));
+
     // Calculate random spawn position within radius
     FVector Origin = GetActorLocation();
-    
-	float Angle = FMath::FRandRange(0.0f, 2 * PI); // Random angle in radians
+    FVector SpawnLocation;
+
+    if (!ReachableCellTable.IsEmpty())
+    {
+        // Pick a reachable cell, favouring ones more aims can hit, then a point inside it
+        const float U0 = SlotStream.GetFraction();
+        const float U1 = SlotStream.GetFraction();
+        const int32 Cell = ReachableCells[ReachableCellTable.Sample(U0, U1)];
+
+        const FVector Jitter(SlotStream.FRandRange(-0.5f, 0.5f), SlotStream.FRandRange(-0.5f, 0.5f), SlotStream.FRandRange(-0.5f, 0.5f));
+        SpawnLocation = Origin + ThrowOrigin + ReachabilityGrid->GetCellCenter(Cell) + Jitter * ReachabilityGrid->CellSize;
+    }
+    else
+    {
+	    float Angle = SlotStream.FRandRange(0.0f, 2 * PI); // Random angle in radians
 
-	float Distance = FMath::FRandRange(MinSpawnRadius, MaxSpawnRadius); // Random distance from the spawner
+	    float Distance = SlotStream.FRandRange(MinSpawnRadius, MaxSpawnRadius); // Random distance from the spawner
 
-	// convert polar to cartesian coordinates
-	float X = Distance * FMath::Cos(Angle);
-	float Y = Distance * FMath::Sin(Angle);
+	    // convert polar to cartesian coordinates
+	    float X = Distance * FMath::Cos(Angle);
+	    float Y = Distance * FMath::Sin(Angle);
 
-	float Z = FMath::FRandRange(MinSpawnHeight, MaxSpawnHeight); // Random height
+	    float Z = SlotStream.FRandRange(MinSpawnHeight, MaxSpawnHeight); // Random height
 
-	FVector SpawnLocation = Origin + FVector(X, Y, Z);
+	    SpawnLocation = Origin + FVector(X, Y, Z);
+    }
 
     // Default rotation (no rotation needed)
     FRotator SpawnRotation = FRotator::ZeroRotator;
@@ -79,7 +196,103 @@ void ATargetSpawner::SpawnTarget()
 
     if (SpawnedTarget)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Target spawned at: %s"), *SpawnLocation.ToString());
+        SpawnedTarget->InitializeSpawnSlot(this, Slot);
+
+        // Drop entries for targets that expired or were hit
+        for (auto It = SpawnedTargets.CreateIterator(); It; ++It)
+        {
+            if (!It->Value.IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        SpawnedTargets.Add(Slot, SpawnedTarget);
+
+        if (USpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<USpawnDirectorSubsystem>())
+        {
+            Director->NotifyTargetSpawned(this);
+        }
+
+        FBoomerangTelemetry::Record(EBoomerangEvent::Spawn, SpawnLocation, SpawnedTarget->GetUniqueID());
+        UE_LOG(LogBoomerang, Verbose, TEXT("Target spawned at: %s"), *SpawnLocation.ToString());
+    }
+}
+
+
+void ATargetSpawner::OnRep_SpawnSlot()
+{
+    // New session on the server, start counting again
+    if (SpawnSeed != LocalSpawnSeed)
+    {
+        LocalSpawnSeed = SpawnSeed;
+        LocalSpawnSlot = 0;
+    }
+
+    if (SpawnSlot <= 0) return;
+
+    // After a late join only the latest slot is spawned, and coalesced updates catch up a few slots at most
+    const int32 MaxCatchUpSlots = LocalSpawnSlot == 0 ? 1 : 4;
+    LocalSpawnSlot = FMath::Max(LocalSpawnSlot, SpawnSlot - MaxCatchUpSlots);
+
+    while (LocalSpawnSlot < SpawnSlot)
+    {
+        LocalSpawnSlot++;
+        SpawnTargetForSlot(LocalSpawnSlot);
+    }
+}
+
+
+void ATargetSpawner::NotifyTargetHit(int32 Slot)
+{
+    if (Slot != INDEX_NONE && GetNetMode() != NM_Standalone)
+    {
+        MulticastTargetRemoved(Slot);
+    }
+}
+
+
+void ATargetSpawner::MulticastTargetRemoved_Implementation(int32 Slot)
+{
+    if (GetNetMode() != NM_Client) return;
+
+    TWeakObjectPtr<ABoomerangTarget> Target;
+    if (SpawnedTargets.RemoveAndCopyValue(Slot, Target) && Target.IsValid())
+    {
+        Target->Destroy();
+    }
+}
+
+
+void ATargetSpawner::SetSpawnInterval(float NewInterval)
+{
+    SpawnInterval = FMath::Max(NewInterval, 0.01f);
+
+    if (GetWorldTimerManager().IsTimerActive(SpawnTimerHandle))
+    {
+        GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &ATargetSpawner::SpawnTarget, GetEffectiveSpawnInterval(), true);
+    }
+}
+
+
+void ATargetSpawner::SetSpawnArea(float MinRadius, float MaxRadius, float MinHeight, float MaxHeight)
+{
+    MinSpawnRadius = FMath::Max(MinRadius, 0.f);
+    MaxSpawnRadius = FMath::Max(MaxRadius, MinSpawnRadius);
+    MinSpawnHeight = MinHeight;
+    MaxSpawnHeight = FMath::Max(MaxHeight, MinSpawnHeight);
+}
+
+
+void ATargetSpawner::SetSpawnRateScale(float NewScale)
+{
+    SpawnRateScale = FMath::Clamp(NewScale, 0.01f, 1.f);
+
+    if (GetWorldTimerManager().IsTimerActive(SpawnTimerHandle))
+    {
+        // Keep the time already waited so throttling doesn't reset the next spawn
+        const float Elapsed = GetWorldTimerManager().GetTimerElapsed(SpawnTimerHandle);
+        const float Interval = GetEffectiveSpawnInterval();
+        GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &ATargetSpawner::SpawnTarget, Interval, true, FMath::Max(Interval - Elapsed, 0.f));
     }
 }
 
@@ -87,5 +300,5 @@ void ATargetSpawner::SpawnTarget()
 void ATargetSpawner::StopSpawning()
 {
     GetWorldTimerManager().ClearTimer(SpawnTimerHandle);
-    UE_LOG(LogTemp, Warning, TEXT("%s: Spawning stopped."), *GetName());
+    UE_LOG(LogBoomerang, Warning, TEXT("%s: Spawning stopped."), *GetName());
 }
\ No newline at end of file
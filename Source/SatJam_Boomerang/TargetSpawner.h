@@ -5,8 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "BoomerangTarget.h"
+#include "BoomerangAliasTable.h"
 #include "TargetSpawner.generated.h"
 
+class UBoomerangReachabilityGrid;
+
 UCLASS()
 class SATJAM_BOOMERANG_API ATargetSpawner : public AActor
 {
@@ -16,11 +19,36 @@ public:
 	// Sets default values for this actor's properties
 	ATargetSpawner();
 
+	void StartSpawning();
 	void StopSpawning();
 
+	// Changes the spawn interval, restarting the timer if spawning is active
+	void SetSpawnInterval(float NewInterval);
+	float GetSpawnInterval() const { return SpawnInterval; }
+
+	// Placement band around the spawner, used by generated benchmark maps
+	void SetSpawnArea(float MinRadius, float MaxRadius, float MinHeight, float MaxHeight);
+
+	void SetRandomSeed(int32 NewSeed) { RandomSeed = NewSeed; }
+
+	// Scales the spawn rate without touching the configured interval (used by the frame budget governor)
+	void SetSpawnRateScale(float NewScale);
+
+	// Relative share of the global spawn rate, see USpawnDirectorSubsystem
+	float GetSpawnWeight() const { return SpawnWeight; }
+
+	// Seed used for the current session's spawn positions
+	int32 GetSeed() const { return SpawnSeed; }
+
+	// Called on the server when a target from this spawner is hit
+	void NotifyTargetHit(int32 Slot);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -36,6 +64,10 @@ private:
     UPROPERTY(EditAnywhere, Category = "Spawner")
     float SpawnInterval = 5.0f;
 
+    // Relative share of the global spawn rate when several spawners compete for it
+    UPROPERTY(EditAnywhere, Category = "Spawner", meta = (ClampMin = "0.0"))
+    float SpawnWeight = 1.0f;
+
     // minumum distance for how far away from the spawner targets can appear (for random spawn)
     UPROPERTY(EditAnywhere, Category = "Spawner")
     float MinSpawnRadius = 200.0f;
@@ -49,9 +81,62 @@ private:
     UPROPERTY(EditAnywhere, Category = "Spawner")
     float MaxSpawnHeight = 600.0f;
 
+    // Baked reachable volume, when set targets only spawn where a throw from ThrowOrigin can hit them
+    UPROPERTY(EditAnywhere, Category = "Spawner|Reachability")
+    UBoomerangReachabilityGrid* ReachabilityGrid = nullptr;
+
+    // Where the player throws from, relative to the spawner
+    UPROPERTY(EditAnywhere, Category = "Spawner|Reachability", meta = (MakeEditWidget))
+    FVector ThrowOrigin = FVector::ZeroVector;
+
+    // Cells hit by a smaller fraction of aims than this are left out
+    UPROPERTY(EditAnywhere, Category = "Spawner|Reachability", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float MinHitProbability = 0.002f;
+
+    // Fixed seed for reproducible spawns, 0 picks a new seed every session
+    UPROPERTY(EditAnywhere, Category = "Spawner")
+    int32 RandomSeed = 0;
+
+    // Seed for the current session, spawn positions are derived from seed and slot
+    UPROPERTY(Replicated)
+    int32 SpawnSeed = 0;
+
+    // Index of the latest spawn, clients spawn their own copy of each new slot
+    UPROPERTY(ReplicatedUsing = OnRep_SpawnSlot)
+    int32 SpawnSlot = 0;
+
+    // Latest slot spawned locally on a client, and the seed it belonged to
+    int32 LocalSpawnSlot = 0;
+    int32 LocalSpawnSeed = 0;
+
+    // Targets spawned by this spawner, by slot
+    TMap<int32, TWeakObjectPtr<ABoomerangTarget>> SpawnedTargets;
+
+    // Reachable cells inside the spawn band, weighted by hit probability
+    TArray<int32> ReachableCells;
+    FBoomerangAliasTable ReachableCellTable;
+
+    // Filters the reachability grid to this spawner's band, once per play session
+    void BuildReachableCells();
+
+    // Multiplier on the spawn rate, below 1 when the game is over its frame budget
+    float SpawnRateScale = 1.f;
+
+    float GetEffectiveSpawnInterval() const { return SpawnInterval / SpawnRateScale; }
+
     // Timer handle to repeatedly call the spawn function
     FTimerHandle SpawnTimerHandle;
 
     // Function that actually spawns the enemy
     void SpawnTarget();
+
+    // Spawns the target for a slot, same position on every machine
+    void SpawnTargetForSlot(int32 Slot);
+
+    UFUNCTION()
+    void OnRep_SpawnSlot();
+
+    // Removes a hit target on clients
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastTargetRemoved(int32 Slot);
 };
@@ -0,0 +1,157 @@
+// ThrowLatencyTracker.cpp
+
+#include "ThrowLatencyTracker.h"
+#include "SatJam_Boomerang.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(BoomerangLatency, true);
+
+namespace ThrowLatency
+{
+    enum EStage
+    {
+        Spawn,
+        FirstTick,
+        Visible,
+        NumStages
+    };
+
+    static const TCHAR* StageNames[NumStages] = { TEXT("Press to spawn"), TEXT("Press to first tick"), TEXT("Press to visible") };
+
+    // A press with no spawn after this long was rejected, not slow
+    constexpr double MaxPendingSeconds = 2.0;
+
+    static uint64 PressCycles = 0;
+
+    // Throw being timed, and the stages it has reached
+    static TWeakObjectPtr<const AActor> Tracked;
+    static double SpawnWorldTime = 0.0;
+    static bool bTickStamped = false;
+
+    // Milliseconds since the press, per finished throw
+    static TArray<float> Samples[NumStages];
+
+    static float MsSincePress()
+    {
+        return static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - PressCycles));
+    }
+
+    static float Percentile(const TArray<float>& Sorted, float P)
+    {
+        return Sorted[FMath::Clamp(FMath::FloorToInt(P * (Sorted.Num() - 1) + 0.5f), 0, Sorted.Num() - 1)];
+    }
+}
+
+
+void FThrowLatencyTracker::MarkPressed()
+{
+    using namespace ThrowLatency;
+
+    PressCycles = FPlatformTime::Cycles64();
+    Tracked.Reset();
+}
+
+
+void FThrowLatencyTracker::MarkSpawned(const AActor* Boomerang)
+{
+    using namespace ThrowLatency;
+
+    if (PressCycles == 0 || !Boomerang) return;
+
+    const float Ms = MsSincePress();
+    if (Ms > MaxPendingSeconds * 1000.0)
+    {
+        PressCycles = 0;
+        return;
+    }
+
+    Samples[Spawn].Add(Ms);
+    Tracked = Boomerang;
+    SpawnWorldTime = Boomerang->GetWorld()->GetTimeSeconds();
+    bTickStamped = false;
+
+    CSV_CUSTOM_STAT(BoomerangLatency, PressToSpawnMs, Ms, ECsvCustomStatOp::Set);
+}
+
+
+void FThrowLatencyTracker::NotifyBoomerangTick(const AActor* Boomerang)
+{
+    using namespace ThrowLatency;
+
+    if (PressCycles == 0 || Tracked.Get() != Boomerang) return;
+
+    if (!bTickStamped)
+    {
+        const float Ms = MsSincePress();
+        Samples[FirstTick].Add(Ms);
+        bTickStamped = true;
+
+        CSV_CUSTOM_STAT(BoomerangLatency, PressToFirstTickMs, Ms, ECsvCustomStatOp::Set);
+    }
+
+    // The renderer stamps primitives it drew on screen with the world time of that frame
+    bool bVisible = false;
+    Boomerang->ForEachComponent<UPrimitiveComponent>(false, [&bVisible](const UPrimitiveComponent* Primitive)
+    {
+        bVisible |= Primitive->GetLastRenderTimeOnScreen() >= SpawnWorldTime;
+    });
+    if (!bVisible) return;
+
+    // Seen on the first tick after that frame, so this is an upper bound by up to a frame
+    const float Ms = MsSincePress();
+    Samples[Visible].Add(Ms);
+    PressCycles = 0;
+    Tracked.Reset();
+
+    CSV_CUSTOM_STAT(BoomerangLatency, PressToVisibleMs, Ms, ECsvCustomStatOp::Set);
+}
+
+
+void FThrowLatencyTracker::LogReport()
+{
+    using namespace ThrowLatency;
+
+    if (Samples[Spawn].Num() == 0)
+    {
+        UE_LOG(LogBoomerang, Display, TEXT("No throws timed yet."));
+        return;
+    }
+
+    for (int32 Stage = 0; Stage < NumStages; ++Stage)
+    {
+        TArray<float> Sorted = Samples[Stage];
+        if (Sorted.Num() == 0) continue;
+
+        Sorted.Sort();
+        UE_LOG(LogBoomerang, Display, TEXT("%-20s n=%d  min %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms"),
+            StageNames[Stage], Sorted.Num(), Sorted[0], Percentile(Sorted, 0.5f), Percentile(Sorted, 0.95f), Percentile(Sorted, 0.99f), Sorted.Last());
+    }
+}
+
+
+void FThrowLatencyTracker::Reset()
+{
+    using namespace ThrowLatency;
+
+    PressCycles = 0;
+    Tracked.Reset();
+    for (TArray<float>& StageSamples : Samples)
+    {
+        StageSamples.Reset();
+    }
+}
+
+
+static FAutoConsoleCommand ThrowLatencyReportCommand(
+    TEXT("boomerang.ThrowLatencyReport"),
+    TEXT("Logs the latency distribution from Throw press to spawn, first flight tick and first visible frame."),
+    FConsoleCommandDelegate::CreateStatic(&FThrowLatencyTracker::LogReport));
+
+static FAutoConsoleCommand ThrowLatencyResetCommand(
+    TEXT("boomerang.ThrowLatencyReset"),
+    TEXT("Clears the throw latency samples."),
+    FConsoleCommandDelegate::CreateStatic(&FThrowLatencyTracker::Reset));
@@ -0,0 +1,26 @@
+// ThrowLatencyTracker.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+// Times the local player's throws from the Throw press to the boomerang's first visible frame.
+// Game thread only. Report with boomerang.ThrowLatencyReport, per-throw values also go to the
+// BoomerangLatency CSV category.
+struct SATJAM_BOOMERANG_API FThrowLatencyTracker
+{
+    // Throw input handled, before any throw work
+    static void MarkPressed();
+
+    // Boomerang for the pending press spawned (the cosmetic copy on clients, so the round trip counts)
+    static void MarkSpawned(const AActor* Boomerang);
+
+    // Called from every boomerang tick, cheap unless it is the tracked one.
+    // Stamps the first flight tick, then the first tick after the renderer drew it on screen.
+    static void NotifyBoomerangTick(const AActor* Boomerang);
+
+    static void LogReport();
+    static void Reset();
+};
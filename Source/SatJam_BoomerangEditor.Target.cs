@@ -10,6 +10,6 @@ public class SatJam_BoomerangEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
-		ExtraModuleNames.Add("SatJam_Boomerang");
+		ExtraModuleNames.AddRange(new string[] { "SatJam_Boomerang", "SatJam_BoomerangEditor" });
 	}
 }
@@ -0,0 +1,311 @@
+// BakeDistanceFieldCommandlet.cpp
+
+#include "BakeDistanceFieldCommandlet.h"
+#include "SatJam_BoomerangEditor.h"
+#include "BoomerangDistanceField.h"
+#include "BoomerangSettings.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+
+
+UBakeDistanceFieldCommandlet::UBakeDistanceFieldCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+
+namespace BakeDistanceField
+{
+    struct FSource
+    {
+        const UPrimitiveComponent* Component;
+        FBox Bounds;
+        TArray<FBox> ThinShapes;    // world bounds of collision shapes thinner than ThinThreshold
+        bool bUnbaked;              // not Static, may have moved by the time the field is used
+    };
+
+    // Samples of one grid brick, empty when no geometry is within a brick of it
+    struct FBrick
+    {
+        TArray<uint8> Samples;
+        EDistanceFieldBrick Flags = EDistanceFieldBrick::None;
+    };
+
+    // Collision shapes of the component's body setup that have a scaled dimension under ThinThreshold
+    void GatherThinShapes(UPrimitiveComponent* Component, float ThinThreshold, TArray<FBox>& OutShapes)
+    {
+        const UBodySetup* BodySetup = Component->GetBodySetup();
+        if (!BodySetup) return;
+
+        const FTransform ComponentTransform = Component->GetComponentTransform();
+
+        // Triangle mesh collision can't be measured at all, its bricks are flagged Unmeasured while sampling
+        if (BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple) return;
+
+        const FVector Scale = ComponentTransform.GetScale3D().GetAbs();
+        auto AddIfThin = [&](const FVector& LocalExtent, const FTransform& ElemTransform)
+        {
+            if ((LocalExtent * 2.f * Scale).GetMin() < ThinThreshold)
+            {
+                OutShapes.Add(FBox(-LocalExtent, LocalExtent).TransformBy(ElemTransform * ComponentTransform));
+            }
+        };
+
+        const FKAggregateGeom& Geom = BodySetup->AggGeom;
+        for (const FKBoxElem& Elem : Geom.BoxElems)
+        {
+            AddIfThin(FVector(Elem.X, Elem.Y, Elem.Z) * 0.5f, Elem.GetTransform());
+        }
+        for (const FKSphereElem& Elem : Geom.SphereElems)
+        {
+            AddIfThin(FVector(Elem.Radius), Elem.GetTransform());
+        }
+        for (const FKSphylElem& Elem : Geom.SphylElems)
+        {
+            AddIfThin(FVector(Elem.Radius, Elem.Radius, Elem.Length * 0.5f + Elem.Radius), Elem.GetTransform());
+        }
+        for (const FKConvexElem& Elem : Geom.ConvexElems)
+        {
+            AddIfThin(Elem.ElemBox.GetExtent(), FTransform(Elem.ElemBox.GetCenter()) * Elem.GetTransform());
+        }
+    }
+}
+
+
+int32 UBakeDistanceFieldCommandlet::Main(const FString& Params)
+{
+    using namespace BakeDistanceField;
+
+    FString MapPath;
+    if (!FParse::Value(*Params, TEXT("map="), MapPath) || !FPackageName::IsValidLongPackageName(MapPath))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeDistanceField: -map=/Game/... map package is required"));
+        return 1;
+    }
+
+    FString OutputPath = FPackageName::GetLongPackagePath(MapPath) / TEXT("DF_") + FPackageName::GetShortName(MapPath);
+    FParse::Value(*Params, TEXT("output="), OutputPath);
+    if (!FPackageName::IsValidLongPackageName(OutputPath))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeDistanceField: %s is not a valid package path"), *OutputPath);
+        return 1;
+    }
+
+    float VoxelSize = 25.f;
+    FParse::Value(*Params, TEXT("voxelsize="), VoxelSize);
+    VoxelSize = FMath::Max(VoxelSize, 1.f);
+
+    // Walls thinner than two voxels can fall between samples
+    float ThinThreshold = VoxelSize * 2.f;
+    FParse::Value(*Params, TEXT("thin="), ThinThreshold);
+
+    UPackage* MapPackage = LoadPackage(nullptr, *MapPath, LOAD_None);
+    UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeDistanceField: failed to load map %s"), *MapPath);
+        return 1;
+    }
+
+    // Needs a physics scene so the components have bodies to measure
+    World->AddToRoot();
+    World->WorldType = EWorldType::Editor;
+    if (!World->bIsWorldInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues()
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(true)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .ShouldSimulatePhysics(false)
+            .EnableTraceCollision(true)
+            .SetTransactional(false)
+            .CreateFXSystem(false));
+    }
+    World->UpdateWorldComponents(true, false);
+
+    // Everything in the level the flight's ECC_WorldStatic sweep could hit. Props spawned at runtime are
+    // handled by UBoomerangDistanceFieldSubsystem, movable ones get their bricks marked for the physics fallback.
+    TArray<FSource> Sources;
+    FBox GeometryBounds(ForceInit);
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        TInlineComponentArray<UPrimitiveComponent*> Components(*It);
+        for (UPrimitiveComponent* Component : Components)
+        {
+            if (!Component->IsRegistered() || !Component->IsQueryCollisionEnabled()) continue;
+            if (Component->GetCollisionObjectType() != ECC_WorldStatic) continue;
+
+            FSource& Source = Sources.Add_GetRef({ Component, Component->Bounds.GetBox(), {}, Component->Mobility != EComponentMobility::Static });
+            GatherThinShapes(Component, ThinThreshold, Source.ThinShapes);
+            GeometryBounds += Source.Bounds;
+        }
+    }
+
+    if (Sources.Num() == 0)
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeDistanceField: %s has no static collision"), *MapPath);
+        return 1;
+    }
+
+    constexpr int32 BrickCells = UBoomerangDistanceField::BrickCells;
+    constexpr int32 BrickSamples = UBoomerangDistanceField::BrickSamples;
+    const float Band = VoxelSize * BrickCells;
+
+    // A brick of margin all round, the runtime relies on geometry being at least a brick inside the field
+    const FBox FieldBounds = GeometryBounds.ExpandBy(Band);
+    const FVector FieldSize = FieldBounds.GetSize();
+    const FIntVector NumBricks(
+        FMath::CeilToInt32(FieldSize.X / Band),
+        FMath::CeilToInt32(FieldSize.Y / Band),
+        FMath::CeilToInt32(FieldSize.Z / Band));
+    const int32 NumGridBricks = NumBricks.X * NumBricks.Y * NumBricks.Z;
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("BakeDistanceField: %d components, %dx%dx%d bricks of %d^3 voxels of %.0f"),
+        Sources.Num(), NumBricks.X, NumBricks.Y, NumBricks.Z, BrickCells, VoxelSize);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FBrick> Bricks;
+    Bricks.SetNum(NumGridBricks);
+    ParallelFor(TEXT("BakeDistanceField"), NumGridBricks, 1, [&](int32 BrickIndex)
+    {
+        const FIntVector Brick(
+            BrickIndex % NumBricks.X,
+            (BrickIndex / NumBricks.X) % NumBricks.Y,
+            BrickIndex / (NumBricks.X * NumBricks.Y));
+
+        const FVector BrickMin = FieldBounds.Min + FVector(Brick) * Band;
+        const FBox Reach = FBox(BrickMin, BrickMin + FVector(Band)).ExpandBy(Band);
+
+        FBrick& Out = Bricks[BrickIndex];
+        TArray<const FSource*, TInlineAllocator<16>> Candidates;
+        for (const FSource& Source : Sources)
+        {
+            if (!Source.Bounds.Intersect(Reach)) continue;
+
+            Candidates.Add(&Source);
+            if (Source.bUnbaked)
+            {
+                Out.Flags |= EDistanceFieldBrick::Unbaked;
+            }
+            for (const FBox& Shape : Source.ThinShapes)
+            {
+                if (Shape.Intersect(Reach))
+                {
+                    Out.Flags |= EDistanceFieldBrick::Thin;
+                    break;
+                }
+            }
+        }
+
+        if (Candidates.Num() == 0) return;
+
+        Out.Samples.SetNumUninitialized(UBoomerangDistanceField::SamplesPerBrick);
+        float Closest = UE_BIG_NUMBER;
+
+        for (int32 Z = 0; Z < BrickSamples; ++Z)
+        for (int32 Y = 0; Y < BrickSamples; ++Y)
+        for (int32 X = 0; X < BrickSamples; ++X)
+        {
+            const FVector Point = BrickMin + FVector(X, Y, Z) * VoxelSize;
+
+            float Distance = UE_BIG_NUMBER;
+            for (const FSource* Source : Candidates)
+            {
+                FVector ClosestPoint;
+                const float SourceDistance = Source->Component->GetDistanceToCollision(Point, ClosestPoint);
+                if (SourceDistance < 0.f)
+                {
+                    // Triangle meshes and heightfields (landscape) can't be measured, claim no clearance and leave the brick to physics
+                    Out.Flags |= EDistanceFieldBrick::Unmeasured;
+                    Distance = 0.f;
+                    continue;
+                }
+
+                Distance = FMath::Min(Distance, SourceDistance);
+            }
+            Closest = FMath::Min(Closest, Distance);
+
+            // Rounded down, so the field never claims more clearance than there is
+            Out.Samples[X + BrickSamples * (Y + BrickSamples * Z)] = static_cast<uint8>(FMath::Clamp(FMath::FloorToInt32(Distance / Band * 255.f), 0, 255));
+        }
+
+        // Nothing actually within reach, the bounds only overlapped. Leave a voxel of slack for what lies between samples.
+        if (Out.Flags == EDistanceFieldBrick::None && Closest >= Band + VoxelSize)
+        {
+            Out.Samples.Empty();
+        }
+    });
+
+    UPackage* Package = CreatePackage(*OutputPath);
+    Package->FullyLoad();
+
+    const FName AssetName(FPackageName::GetLongPackageAssetName(OutputPath));
+    UBoomerangDistanceField* Field = FindObject<UBoomerangDistanceField>(Package, *AssetName.ToString());
+    if (!Field)
+    {
+        Field = NewObject<UBoomerangDistanceField>(Package, AssetName, RF_Public | RF_Standalone);
+        FAssetRegistryModule::AssetCreated(Field);
+    }
+
+    Field->VoxelSize = VoxelSize;
+    Field->FieldMin = FieldBounds.Min;
+    Field->NumBricks = NumBricks;
+    Field->ThinThreshold = ThinThreshold;
+    Field->NumComponents = Sources.Num();
+    Field->BrickSlots.Init(INDEX_NONE, NumGridBricks);
+    Field->Samples.Reset();
+    Field->BrickFlags.Reset();
+
+    for (int32 BrickIndex = 0; BrickIndex < NumGridBricks; ++BrickIndex)
+    {
+        const FBrick& Brick = Bricks[BrickIndex];
+        if (Brick.Samples.Num() == 0) continue;
+
+        Field->BrickSlots[BrickIndex] = Field->BrickFlags.Add(static_cast<uint8>(Brick.Flags));
+        Field->Samples.Append(Brick.Samples);
+    }
+
+    Field->MarkPackageDirty();
+
+    const FString Filename = FPackageName::LongPackageNameToFilename(OutputPath, FPackageName::GetAssetPackageExtension());
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    if (!UPackage::SavePackage(Package, Field, *Filename, SaveArgs))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeDistanceField: failed to save %s"), *Filename);
+        return 1;
+    }
+
+    // Point the map at the new field
+    UBoomerangSettings* Settings = GetMutableDefault<UBoomerangSettings>();
+    Settings->ArenaDistanceFields.Add(TSoftObjectPtr<UWorld>(FSoftObjectPath(World)), TSoftObjectPtr<UBoomerangDistanceField>(Field));
+    Settings->TryUpdateDefaultConfigFile();
+
+    int32 NumThin = 0;
+    int32 NumUnbaked = 0;
+    int32 NumUnmeasured = 0;
+    for (uint8 Flags : Field->BrickFlags)
+    {
+        NumThin += EnumHasAnyFlags(static_cast<EDistanceFieldBrick>(Flags), EDistanceFieldBrick::Thin);
+        NumUnbaked += EnumHasAnyFlags(static_cast<EDistanceFieldBrick>(Flags), EDistanceFieldBrick::Unbaked);
+        NumUnmeasured += EnumHasAnyFlags(static_cast<EDistanceFieldBrick>(Flags), EDistanceFieldBrick::Unmeasured);
+    }
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("BakeDistanceField: %d of %d bricks stored (%d thin, %d unbaked, %d unmeasured), %.1f KB, baked in %.2f s, saved %s"),
+        Field->GetNumStoredBricks(), NumGridBricks, NumThin, NumUnbaked, NumUnmeasured, Field->Samples.Num() / 1024.f, FPlatformTime::Seconds() - StartTime, *Filename);
+
+    World->RemoveFromRoot();
+    return 0;
+}
@@ -0,0 +1,22 @@
+// BakeDistanceFieldCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeDistanceFieldCommandlet.generated.h"
+
+// Bakes the static collision of a map into a sparse UBoomerangDistanceField and registers it for that map
+// in UBoomerangSettings::ArenaDistanceFields. Sublevels are not loaded, bake each arena from its persistent map.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=BakeDistanceField -map=/Game/Level
+//     [-output=/Game/Data/DF_Level] [-voxelsize=25] [-thin=50]
+UCLASS()
+class UBakeDistanceFieldCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBakeDistanceFieldCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,205 @@
+// BakeReachabilityCommandlet.cpp
+
+#include "BakeReachabilityCommandlet.h"
+#include "SatJam_BoomerangEditor.h"
+#include "BoomerangReachabilityGrid.h"
+#include "BoomerangThrowDescriptor.h"
+#include "BoomerangActor.h"
+#include "PlayerPawnBoomerang.h"
+#include "BoomerangTrajectory.h"
+#include "BoomerangTrajectoryLibrary.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+
+
+UBakeReachabilityCommandlet::UBakeReachabilityCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+
+namespace BakeReachability
+{
+    // Per-worker counts, so workers never write to the same cell
+    struct FContext
+    {
+        TArray<int32> HitCounts;
+
+        // Last aim that touched each cell, so one path counts a cell once
+        TArray<int32> LastAim;
+    };
+}
+
+
+int32 UBakeReachabilityCommandlet::Main(const FString& Params)
+{
+    using namespace BakeReachability;
+
+    FString OutputPath;
+    if (!FParse::Value(*Params, TEXT("output="), OutputPath) || !FPackageName::IsValidLongPackageName(OutputPath))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeReachability: -output=/Game/... package path is required"));
+        return 1;
+    }
+
+    float TargetRadius = 50.f;
+    float CellSize = 50.f;
+    int32 YawSteps = 72;
+    int32 PitchSteps = 90;
+    FParse::Value(*Params, TEXT("targetradius="), TargetRadius);
+    FParse::Value(*Params, TEXT("cellsize="), CellSize);
+    FParse::Value(*Params, TEXT("yawsteps="), YawSteps);
+    FParse::Value(*Params, TEXT("pitchsteps="), PitchSteps);
+    CellSize = FMath::Max(CellSize, 1.f);
+    YawSteps = FMath::Max(YawSteps, 1);
+    PitchSteps = FMath::Max(PitchSteps, 2);
+
+    // Throw shape comes from the pawn, exactly as MakeThrowDescriptor quantizes it
+    UClass* PawnClass = APlayerPawnBoomerang::StaticClass();
+    FString PawnPath;
+    if (FParse::Value(*Params, TEXT("pawn="), PawnPath))
+    {
+        PawnClass = LoadObject<UClass>(nullptr, *PawnPath);
+        if (!PawnClass || !PawnClass->IsChildOf<APlayerPawnBoomerang>())
+        {
+            UE_LOG(LogBoomerangEditor, Error, TEXT("BakeReachability: %s is not a APlayerPawnBoomerang class"), *PawnPath);
+            return 1;
+        }
+    }
+
+    const APlayerPawnBoomerang* Pawn = PawnClass->GetDefaultObject<APlayerPawnBoomerang>();
+    const FBoomerangThrowDescriptor Shape = Pawn->MakeThrowDescriptor(FRotator::ZeroRotator);
+
+    float SweepRadius = 0.f;
+    if (TSubclassOf<ABoomerangActor> BoomerangClass = Pawn->GetBoomerangClass())
+    {
+        SweepRadius = BoomerangClass->GetDefaultObject<ABoomerangActor>()->GetSweepRadius();
+    }
+
+    const float HitRadius = SweepRadius + TargetRadius;
+    const TConstArrayView<FVector3f> ShapeTable = UBoomerangTrajectoryLibrary::GetTable(Shape.Shape);
+
+    // Furthest the path gets from the start, the grid only needs to cover that
+    const float Extent = Shape.GetMaxRadius() + HitRadius;
+    const int32 Size = FMath::CeilToInt(2.f * Extent / CellSize);
+    const FIntVector Dims(Size, Size, Size);
+    const FVector GridMin(-Size * CellSize * 0.5f);
+    const int32 NumCells = Dims.X * Dims.Y * Dims.Z;
+    const int32 NumAims = YawSteps * PitchSteps;
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("BakeReachability: distance %d, curve %d, %d segments, hit radius %.1f, %d^3 cells of %.0f, %d aims"),
+        Shape.Distance, Shape.CurveRadius, Shape.NumSegments, HitRadius, Size, CellSize, NumAims);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 CellReach = FMath::CeilToInt(HitRadius / CellSize);
+    const float Step = CellSize * 0.5f;
+
+    TArray<FContext> Contexts;
+    ParallelForWithTaskContext(TEXT("BakeReachability"), Contexts, NumAims, [&](FContext& Context, int32 AimIndex)
+    {
+        if (Context.HitCounts.Num() == 0)
+        {
+            Context.HitCounts.SetNumZeroed(NumCells);
+            Context.LastAim.Init(INDEX_NONE, NumCells);
+        }
+
+        // Pitch covers the same +-89 the pawn allows
+        const float Yaw = 360.f * (AimIndex % YawSteps) / YawSteps;
+        const float Pitch = FMath::Lerp(-89.f, 89.f, static_cast<float>(AimIndex / YawSteps) / (PitchSteps - 1));
+
+        TArray<FVector> Path;
+        BoomerangMath::BuildPath(FVector::ZeroVector, FRotator(Pitch, Yaw, 0.f), Shape.Distance, Shape.CurveRadius, Shape.NumSegments, ShapeTable, Path);
+
+        for (int32 Seg = 0; Seg + 1 < Path.Num(); ++Seg)
+        {
+            const int32 NumSteps = FMath::Max(FMath::CeilToInt(FVector::Dist(Path[Seg], Path[Seg + 1]) / Step), 1);
+            for (int32 StepIndex = 0; StepIndex <= NumSteps; ++StepIndex)
+            {
+                const FVector Point = FMath::Lerp(Path[Seg], Path[Seg + 1], static_cast<float>(StepIndex) / NumSteps);
+                const FIntVector Center(
+                    FMath::FloorToInt((Point.X - GridMin.X) / CellSize),
+                    FMath::FloorToInt((Point.Y - GridMin.Y) / CellSize),
+                    FMath::FloorToInt((Point.Z - GridMin.Z) / CellSize));
+
+                // Every cell whose centre is within hit range of this point
+                for (int32 Z = Center.Z - CellReach; Z <= Center.Z + CellReach; ++Z)
+                for (int32 Y = Center.Y - CellReach; Y <= Center.Y + CellReach; ++Y)
+                for (int32 X = Center.X - CellReach; X <= Center.X + CellReach; ++X)
+                {
+                    if (X < 0 || Y < 0 || Z < 0 || X >= Dims.X || Y >= Dims.Y || Z >= Dims.Z) continue;
+
+                    const int32 Cell = X + Dims.X * (Y + Dims.Y * Z);
+                    if (Context.LastAim[Cell] == AimIndex) continue;
+
+                    const FVector CellCenter = GridMin + (FVector(X, Y, Z) + 0.5) * CellSize;
+                    if (FVector::DistSquared(CellCenter, Point) > FMath::Square(HitRadius)) continue;
+
+                    Context.LastAim[Cell] = AimIndex;
+                    Context.HitCounts[Cell]++;
+                }
+            }
+        }
+    });
+
+    TArray<int32> HitCounts;
+    HitCounts.SetNumZeroed(NumCells);
+    for (const FContext& Context : Contexts)
+    {
+        for (int32 Cell = 0; Cell < Context.HitCounts.Num(); ++Cell)
+        {
+            HitCounts[Cell] += Context.HitCounts[Cell];
+        }
+    }
+
+    // Save only the reachable cells
+    UPackage* Package = CreatePackage(*OutputPath);
+    Package->FullyLoad();
+
+    const FName AssetName(FPackageName::GetLongPackageAssetName(OutputPath));
+    UBoomerangReachabilityGrid* Grid = FindObject<UBoomerangReachabilityGrid>(Package, *AssetName.ToString());
+    if (!Grid)
+    {
+        Grid = NewObject<UBoomerangReachabilityGrid>(Package, AssetName, RF_Public | RF_Standalone);
+        FAssetRegistryModule::AssetCreated(Grid);
+    }
+
+    Grid->CellSize = CellSize;
+    Grid->GridMin = GridMin;
+    Grid->Dims = Dims;
+    Grid->Distance = Shape.Distance;
+    Grid->CurveRadius = Shape.CurveRadius;
+    Grid->NumSegments = Shape.NumSegments;
+    Grid->HitRadius = HitRadius;
+    Grid->NumAims = NumAims;
+    Grid->CellIndices.Reset();
+    Grid->HitProbability.Reset();
+
+    for (int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        if (HitCounts[Cell] == 0) continue;
+
+        Grid->CellIndices.Add(Cell);
+        Grid->HitProbability.Add(static_cast<float>(HitCounts[Cell]) / NumAims);
+    }
+
+    Grid->MarkPackageDirty();
+
+    const FString Filename = FPackageName::LongPackageNameToFilename(OutputPath, FPackageName::GetAssetPackageExtension());
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    if (!UPackage::SavePackage(Package, Grid, *Filename, SaveArgs))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("BakeReachability: failed to save %s"), *Filename);
+        return 1;
+    }
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("BakeReachability: %d of %d cells reachable, baked in %.2f s, saved %s"),
+        Grid->CellIndices.Num(), NumCells, FPlatformTime::Seconds() - StartTime, *Filename);
+    return 0;
+}
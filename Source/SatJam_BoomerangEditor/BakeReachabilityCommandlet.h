@@ -0,0 +1,21 @@
+// BakeReachabilityCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeReachabilityCommandlet.generated.h"
+
+// Sweeps the aim space of a boomerang throw and bakes which cells it can hit into a UBoomerangReachabilityGrid.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=BakeReachability -output=/Game/Data/DA_Reachability
+//     [-pawn=/Game/Blueprints/BP_Player.BP_Player_C] [-targetradius=50] [-cellsize=50] [-yawsteps=72] [-pitchsteps=90]
+UCLASS()
+class UBakeReachabilityCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UBakeReachabilityCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
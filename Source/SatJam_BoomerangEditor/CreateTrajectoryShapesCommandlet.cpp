@@ -0,0 +1,133 @@
+// CreateTrajectoryShapesCommandlet.cpp
+
+#include "CreateTrajectoryShapesCommandlet.h"
+#include "SatJam_BoomerangEditor.h"
+#include "BoomerangTrajectoryShape.h"
+#include "BoomerangSettings.h"
+#include "Curves/CurveVector.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+
+
+UCreateTrajectoryShapesCommandlet::UCreateTrajectoryShapesCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+
+namespace CreateTrajectoryShapes
+{
+    // Keys per curve, cubic with auto tangents between them
+    constexpr int32 NumKeys = 17;
+
+    // Shape table units: X forward in Distance, Y right and Z up in CurveRadius
+    struct FPreset
+    {
+        const TCHAR* Name;
+        FVector (*Evaluate)(float T);
+    };
+
+    static const FPreset Presets[] =
+    {
+        // Out and back along the throw line, crossing itself halfway out and halfway back
+        { TEXT("FigureEight"), [](float T) { return FVector(0.5f * (1.f - FMath::Cos(T * 2.f * PI)), FMath::Sin(T * 4.f * PI), 0.f); } },
+
+        // The built-in loop, climbing on the way out and dropping back to the hand
+        { TEXT("ClimbingLoop"), [](float T) { return FVector(FMath::Sin(T * PI), FMath::Sin(T * 2.f * PI), 1.5f * FMath::Square(FMath::Sin(T * PI))); } },
+
+        // One wide sweep to the right, coming back tighter than it went out
+        { TEXT("WideArc"), [](float T) { return FVector(FMath::Sin(T * PI), 1.5f * FMath::Sin(T * PI) * (1.f - 0.5f * T), 0.f); } },
+    };
+
+    template<typename AssetType>
+    static AssetType* CreateAsset(const FString& PackagePath)
+    {
+        UPackage* Package = CreatePackage(*PackagePath);
+        Package->FullyLoad();
+
+        const FString AssetName = FPackageName::GetLongPackageAssetName(PackagePath);
+        AssetType* Asset = FindObject<AssetType>(Package, *AssetName);
+        if (!Asset)
+        {
+            Asset = NewObject<AssetType>(Package, *AssetName, RF_Public | RF_Standalone);
+            FAssetRegistryModule::AssetCreated(Asset);
+        }
+        return Asset;
+    }
+
+    static bool SaveAsset(UObject* Asset)
+    {
+        UPackage* Package = Asset->GetOutermost();
+        Package->MarkPackageDirty();
+
+        const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        if (!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+        {
+            UE_LOG(LogBoomerangEditor, Error, TEXT("CreateTrajectoryShapes: failed to save %s"), *Filename);
+            return false;
+        }
+        return true;
+    }
+}
+
+
+int32 UCreateTrajectoryShapesCommandlet::Main(const FString& Params)
+{
+    using namespace CreateTrajectoryShapes;
+
+    FString OutputDir = TEXT("/Game/Data/Trajectories");
+    FParse::Value(*Params, TEXT("outdir="), OutputDir);
+    if (!FPackageName::IsValidLongPackageName(OutputDir / TEXT("Probe")))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("CreateTrajectoryShapes: %s is not a valid package path"), *OutputDir);
+        return 1;
+    }
+
+    UBoomerangSettings* Settings = GetMutableDefault<UBoomerangSettings>();
+
+    for (const FPreset& Preset : Presets)
+    {
+        UCurveVector* Curve = CreateAsset<UCurveVector>(OutputDir / TEXT("Curve_") + Preset.Name);
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            FRichCurve& AxisCurve = Curve->FloatCurves[Axis];
+            AxisCurve.Reset();
+
+            for (int32 Key = 0; Key < NumKeys; ++Key)
+            {
+                const float T = static_cast<float>(Key) / (NumKeys - 1);
+                const FKeyHandle Handle = AxisCurve.AddKey(T, static_cast<float>(Preset.Evaluate(T)[Axis]));
+                AxisCurve.SetKeyInterpMode(Handle, RCIM_Cubic);
+            }
+            AxisCurve.AutoSetTangents();
+        }
+
+        if (!SaveAsset(Curve)) return 1;
+
+        // Saving bakes the table
+        UBoomerangTrajectoryShape* Shape = CreateAsset<UBoomerangTrajectoryShape>(OutputDir / TEXT("TS_") + Preset.Name);
+        Shape->Curve = Curve;
+
+        if (!SaveAsset(Shape)) return 1;
+
+        // Appended, never reordered, so ids already in use stay valid
+        const TSoftObjectPtr<UBoomerangTrajectoryShape> ShapeRef(Shape);
+        if (!Settings->TrajectoryShapes.Contains(ShapeRef))
+        {
+            Settings->TrajectoryShapes.Add(ShapeRef);
+        }
+
+        UE_LOG(LogBoomerangEditor, Display, TEXT("CreateTrajectoryShapes: %s baked into %d points, shape id %d"),
+            *Shape->GetPathName(), Shape->GetTable().Num(), Settings->TrajectoryShapes.IndexOfByKey(ShapeRef) + 1);
+    }
+
+    Settings->TryUpdateDefaultConfigFile();
+    return 0;
+}
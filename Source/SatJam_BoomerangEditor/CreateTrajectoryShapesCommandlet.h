@@ -0,0 +1,22 @@
+// CreateTrajectoryShapesCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CreateTrajectoryShapesCommandlet.generated.h"
+
+// Authors the stock trajectory shapes (figure-eight, climbing loop, wide arc) as vector curves plus
+// UBoomerangTrajectoryShape assets, bakes them and registers them in UBoomerangSettings::TrajectoryShapes.
+// Existing assets are overwritten, so hand edits to the stock curves are lost.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=CreateTrajectoryShapes [-outdir=/Game/Data/Trajectories]
+UCLASS()
+class UCreateTrajectoryShapesCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCreateTrajectoryShapesCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,195 @@
+// GenerateStressMapCommandlet.cpp
+
+#include "GenerateStressMapCommandlet.h"
+#include "SatJam_BoomerangEditor.h"
+#include "TargetSpawner.h"
+#include "GameManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/PlayerStart.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+
+
+UGenerateStressMapCommandlet::UGenerateStressMapCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+
+namespace GenerateStressMap
+{
+    // Engine cube is 100 units on a side
+    constexpr float CubeSize = 100.f;
+
+    // Keep walls and spawners clear of the player in the middle
+    constexpr float PlayerClearance = 400.f;
+
+    static AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* Mesh, const FVector& Location, const FRotator& Rotation, const FVector& Size, const FString& Label)
+    {
+        AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, Rotation);
+        Actor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+        Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Static);
+        Actor->SetActorScale3D(Size / CubeSize);
+        Actor->SetActorLabel(Label);
+        return Actor;
+    }
+
+    template<typename ClassType>
+    static UClass* LoadClassParam(const FString& Params, const TCHAR* Name, const TCHAR* DefaultPath)
+    {
+        FString Path = DefaultPath;
+        FParse::Value(*Params, Name, Path);
+
+        UClass* Class = LoadObject<UClass>(nullptr, *Path);
+        if (!Class || !Class->IsChildOf<ClassType>())
+        {
+            UE_LOG(LogBoomerangEditor, Error, TEXT("GenerateStressMap: %s is not a %s class"), *Path, *ClassType::StaticClass()->GetName());
+            return nullptr;
+        }
+        return Class;
+    }
+}
+
+
+int32 UGenerateStressMapCommandlet::Main(const FString& Params)
+{
+    using namespace GenerateStressMap;
+
+    FString OutputPath;
+    if (!FParse::Value(*Params, TEXT("output="), OutputPath) || !FPackageName::IsValidLongPackageName(OutputPath))
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("GenerateStressMap: -output=/Game/... package path is required"));
+        return 1;
+    }
+
+    int32 NumWalls = 200;
+    int32 NumSpawners = 8;
+    float TargetRate = 4.f;     // targets per second across all spawners
+    float Extent = 6000.f;      // half size of the arena
+    int32 Seed = 1;
+    FString Layout = TEXT("grid");
+    FParse::Value(*Params, TEXT("walls="), NumWalls);
+    FParse::Value(*Params, TEXT("spawners="), NumSpawners);
+    FParse::Value(*Params, TEXT("targetrate="), TargetRate);
+    FParse::Value(*Params, TEXT("extent="), Extent);
+    FParse::Value(*Params, TEXT("seed="), Seed);
+    FParse::Value(*Params, TEXT("layout="), Layout);
+    NumWalls = FMath::Max(NumWalls, 0);
+    NumSpawners = FMath::Max(NumSpawners, 1);
+    TargetRate = FMath::Max(TargetRate, 0.01f);
+    Extent = FMath::Max(Extent, PlayerClearance * 2.f);
+
+    UClass* SpawnerClass = LoadClassParam<ATargetSpawner>(Params, TEXT("spawnerclass="), TEXT("/Game/Blueprints/MyTargetSpawner.MyTargetSpawner_C"));
+    UClass* GameManagerClass = LoadClassParam<AGameManager>(Params, TEXT("gamemanagerclass="), TEXT("/Game/Blueprints/MyGameManager.MyGameManager_C"));
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (!SpawnerClass || !GameManagerClass || !Cube) return 1;
+
+    UPackage* Package = CreatePackage(*OutputPath);
+    const FName WorldName(FPackageName::GetLongPackageAssetName(OutputPath));
+
+    UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, WorldName, Package);
+    World->SetFlags(RF_Public | RF_Standalone);
+
+    FRandomStream Stream(Seed);
+
+    // Floor, walls sit on it and boomerangs settle on it
+    SpawnBox(World, Cube, FVector(0.f, 0.f, -CubeSize * 0.5f), FRotator::ZeroRotator, FVector(Extent * 2.f, Extent * 2.f, CubeSize), TEXT("Floor"));
+
+    // Walls: 400 x 40 x 300 slabs, either a regular grid or scattered
+    const FVector WallSize(400.f, 40.f, 300.f);
+    int32 NumPlaced = 0;
+    if (Layout == TEXT("random"))
+    {
+        for (int32 i = 0; NumPlaced < NumWalls && i < NumWalls * 4; ++i)
+        {
+            const FVector Location(Stream.FRandRange(-Extent, Extent), Stream.FRandRange(-Extent, Extent), WallSize.Z * 0.5f);
+            const FRotator Rotation(0.f, Stream.FRandRange(0.f, 180.f), 0.f);
+            if (Location.Size2D() < PlayerClearance) continue;
+
+            SpawnBox(World, Cube, Location, Rotation, WallSize, FString::Printf(TEXT("Wall_%d"), NumPlaced));
+            NumPlaced++;
+        }
+    }
+    else
+    {
+        auto CellCenter = [Extent](int32 Cell, int32 Side)
+        {
+            const float Spacing = 2.f * Extent / Side;
+            return FVector(-Extent + (Cell % Side + 0.5f) * Spacing, -Extent + (Cell / Side + 0.5f) * Spacing, 0.f);
+        };
+
+        // Grow the grid until it has a free cell per wall outside the player clearance, but keep cells at least a wall wide
+        const int32 MaxGridSide = FMath::Max(FMath::FloorToInt32(2.f * Extent / WallSize.X), 1);
+        int32 GridSide = FMath::Clamp(FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumWalls))), 1, MaxGridSide);
+        for (;; ++GridSide)
+        {
+            int32 NumFree = 0;
+            for (int32 Cell = 0; Cell < GridSide * GridSide; ++Cell)
+            {
+                NumFree += CellCenter(Cell, GridSide).Size2D() >= PlayerClearance;
+            }
+            if (NumFree >= NumWalls || GridSide >= MaxGridSide) break;
+        }
+
+        // Each cell holds at most one wall
+        for (int32 Cell = 0; NumPlaced < NumWalls && Cell < GridSide * GridSide; ++Cell)
+        {
+            const FVector Center = CellCenter(Cell, GridSide);
+            if (Center.Size2D() < PlayerClearance) continue;
+
+            SpawnBox(World, Cube, Center + FVector(0.f, 0.f, WallSize.Z * 0.5f), FRotator(0.f, (Cell % 2) * 90.f, 0.f), WallSize, FString::Printf(TEXT("Wall_%d"), NumPlaced));
+            NumPlaced++;
+        }
+    }
+
+    if (NumPlaced < NumWalls)
+    {
+        UE_LOG(LogBoomerangEditor, Warning, TEXT("GenerateStressMap: only room for %d of %d walls"), NumPlaced, NumWalls);
+    }
+
+    // Spawners on a ring, each covering its slice of the arena, sharing the target rate evenly
+    const float RingRadius = Extent * 0.5f;
+    const float SpawnRadius = FMath::Min(RingRadius, 2.f * PI * RingRadius / NumSpawners);
+    for (int32 i = 0; i < NumSpawners; ++i)
+    {
+        const float Angle = 2.f * PI * i / NumSpawners;
+        const FVector Location(RingRadius * FMath::Cos(Angle), RingRadius * FMath::Sin(Angle), 0.f);
+
+        ATargetSpawner* Spawner = World->SpawnActor<ATargetSpawner>(SpawnerClass, Location, FRotator::ZeroRotator);
+        Spawner->SetSpawnInterval(NumSpawners / TargetRate);
+        Spawner->SetSpawnArea(0.f, SpawnRadius, 40.f, 600.f);
+        Spawner->SetRandomSeed(Seed * 1000 + i + 1);
+        Spawner->SetActorLabel(FString::Printf(TEXT("TargetSpawner_%d"), i));
+    }
+
+    World->SpawnActor<APlayerStart>(FVector(0.f, 0.f, 100.f), FRotator::ZeroRotator)->SetActorLabel(TEXT("PlayerStart"));
+    World->SpawnActor<AGameManager>(GameManagerClass, FVector::ZeroVector, FRotator::ZeroRotator)->SetActorLabel(TEXT("GameManager"));
+
+    FAssetRegistryModule::AssetCreated(World);
+    Package->MarkPackageDirty();
+
+    const FString Filename = FPackageName::LongPackageNameToFilename(OutputPath, FPackageName::GetMapPackageExtension());
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    const bool bSaved = UPackage::SavePackage(Package, World, *Filename, SaveArgs);
+
+    World->DestroyWorld(false);
+
+    if (!bSaved)
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("GenerateStressMap: failed to save %s"), *Filename);
+        return 1;
+    }
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("GenerateStressMap: %d walls (%s), %d spawners at %.2f targets/s, saved %s"),
+        NumPlaced, *Layout, NumSpawners, TargetRate, *Filename);
+    return 0;
+}
@@ -0,0 +1,23 @@
+// GenerateStressMapCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GenerateStressMapCommandlet.generated.h"
+
+// Builds a benchmark map with many walls and spawners, for Scripts/stress_benchmark.py.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=GenerateStressMap -output=/Game/Benchmark/Stress_W200_S8
+//     [-walls=200] [-layout=grid|random] [-spawners=8] [-targetrate=4] [-extent=6000] [-seed=1]
+//     [-spawnerclass=/Game/Blueprints/MyTargetSpawner.MyTargetSpawner_C]
+//     [-gamemanagerclass=/Game/Blueprints/MyGameManager.MyGameManager_C]
+UCLASS()
+class UGenerateStressMapCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGenerateStressMapCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
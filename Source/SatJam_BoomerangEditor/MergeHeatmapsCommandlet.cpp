@@ -0,0 +1,129 @@
+// MergeHeatmapsCommandlet.cpp
+
+#include "MergeHeatmapsCommandlet.h"
+#include "SatJam_BoomerangEditor.h"
+#include "BoomerangHeatmap.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+UMergeHeatmapsCommandlet::UMergeHeatmapsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+
+namespace MergeHeatmaps
+{
+    // Per-worker aggregate, so workers never add into the same grid
+    struct FContext
+    {
+        FBoomerangHeatmap Heatmap;
+        int32 NumSkipped = 0;
+    };
+
+    // One CSV row per grid row, Cells holds Rows * Columns values
+    static bool SaveGridCsv(const FString& Path, const TArray<uint32>& Cells, int32 Rows, int32 Columns)
+    {
+        TArray<FString> Lines;
+        Lines.Reserve(Rows);
+
+        for (int32 Row = 0; Row < Rows; ++Row)
+        {
+            FString Line;
+            for (int32 Column = 0; Column < Columns; ++Column)
+            {
+                if (Column > 0) Line += TEXT(',');
+                Line.AppendInt(Cells[Row * Columns + Column]);
+            }
+            Lines.Add(MoveTemp(Line));
+        }
+
+        return FFileHelper::SaveStringArrayToFile(Lines, *Path);
+    }
+
+    // Target grids summed over height, for a top-down view
+    static TArray<uint32> SumLayers(const TArray<uint32>& Cells, int32 NumLayers)
+    {
+        const int32 LayerSize = Cells.Num() / NumLayers;
+
+        TArray<uint32> Summed;
+        Summed.SetNumZeroed(LayerSize);
+        for (int32 i = 0; i < Cells.Num(); ++i)
+        {
+            Summed[i % LayerSize] += Cells[i];
+        }
+        return Summed;
+    }
+}
+
+
+int32 UMergeHeatmapsCommandlet::Main(const FString& Params)
+{
+    using namespace MergeHeatmaps;
+
+    FString InputDir = FPaths::ProjectSavedDir() / TEXT("Heatmaps");
+    FString OutputDir = InputDir / TEXT("Merged");
+    FParse::Value(*Params, TEXT("input="), InputDir);
+    FParse::Value(*Params, TEXT("output="), OutputDir);
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *(InputDir / TEXT("*.bhm")), true, false);
+    if (Files.Num() == 0)
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("MergeHeatmaps: no .bhm files in %s"), *InputDir);
+        return 1;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FContext> Contexts;
+    ParallelForWithTaskContext(TEXT("MergeHeatmaps"), Contexts, Files.Num(), [&](FContext& Context, int32 FileIndex)
+    {
+        FBoomerangHeatmap Session;
+        if (!Session.LoadFromFile(InputDir / Files[FileIndex]) || !Context.Heatmap.Merge(Session))
+        {
+            Context.NumSkipped++;
+        }
+    });
+
+    // Layout comes from the first worker that loaded anything, mismatches are skipped like bad files
+    FBoomerangHeatmap Merged;
+    int32 NumSkipped = 0;
+    for (const FContext& Context : Contexts)
+    {
+        NumSkipped += Context.NumSkipped;
+        if (Context.Heatmap.IsInitialized() && !Merged.Merge(Context.Heatmap))
+        {
+            NumSkipped += Context.Heatmap.NumSessions;
+        }
+    }
+
+    if (!Merged.IsInitialized())
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("MergeHeatmaps: none of the %d files could be read"), Files.Num());
+        return 1;
+    }
+
+    const FBoomerangHeatmapLayout& Layout = Merged.Layout;
+    const bool bSaved = Merged.SaveToFile(OutputDir / TEXT("Merged.bhm"))
+        && SaveGridCsv(OutputDir / TEXT("ThrowDirections.csv"), Merged.ThrowDirections, Layout.PitchBins, Layout.YawBins)
+        && SaveGridCsv(OutputDir / TEXT("GroundImpacts.csv"), Merged.GroundImpacts, Layout.CellsXY, Layout.CellsXY)
+        && SaveGridCsv(OutputDir / TEXT("TargetHits.csv"), SumLayers(Merged.TargetHits, Layout.CellsZ), Layout.CellsXY, Layout.CellsXY)
+        && SaveGridCsv(OutputDir / TEXT("TargetExpires.csv"), SumLayers(Merged.TargetExpires, Layout.CellsZ), Layout.CellsXY, Layout.CellsXY);
+
+    if (!bSaved)
+    {
+        UE_LOG(LogBoomerangEditor, Error, TEXT("MergeHeatmaps: failed to write to %s"), *OutputDir);
+        return 1;
+    }
+
+    UE_LOG(LogBoomerangEditor, Display, TEXT("MergeHeatmaps: %u sessions from %d files merged in %.2fs (%d skipped, %u events outside the grid), written to %s"),
+        Merged.NumSessions, Files.Num(), FPlatformTime::Seconds() - StartTime, NumSkipped, Merged.NumOutside, *OutputDir);
+    return 0;
+}
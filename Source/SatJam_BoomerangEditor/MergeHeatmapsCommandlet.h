@@ -0,0 +1,21 @@
+// MergeHeatmapsCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MergeHeatmapsCommandlet.generated.h"
+
+// Merges session heatmaps written by UBoomerangHeatmapSubsystem into one aggregate, loading files in parallel,
+// and exports each grid as CSV for plotting.
+// UnrealEditor-Cmd SatJam_Boomerang.uproject -run=MergeHeatmaps [-input=Saved/Heatmaps] [-output=Saved/Heatmaps/Merged]
+UCLASS()
+class UMergeHeatmapsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMergeHeatmapsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Editor-only tools and commandlets for the game module
+public class SatJam_BoomerangEditor : ModuleRules
+{
+	public SatJam_BoomerangEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "AssetRegistry", "SatJam_Boomerang", "BoomerangMath" });
+	}
+}
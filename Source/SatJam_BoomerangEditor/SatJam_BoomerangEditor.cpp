@@ -0,0 +1,8 @@
+// SatJam_BoomerangEditor.cpp
+
+#include "SatJam_BoomerangEditor.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY(LogBoomerangEditor);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, SatJam_BoomerangEditor);
@@ -0,0 +1,7 @@
+// SatJam_BoomerangEditor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBoomerangEditor, Log, All);
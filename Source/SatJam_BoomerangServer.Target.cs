@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class SatJam_BoomerangServerTarget : TargetRules
+{
+	public SatJam_BoomerangServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		ExtraModuleNames.Add("SatJam_Boomerang");
+
+		// The settings below change engine modules, so this target builds its own copy of the engine
+		BuildEnvironment = TargetBuildEnvironment.Unique;
+
+		// Headless simulation hosts, keep logs for soak and batch runs
+		bUseLoggingInShipping = true;
+
+		// Bots aim and throw, nothing ever paths
+		bCompileRecast = false;
+
+		// Nothing here is ever looked at
+		bCompileChaosVisualDebuggerSupport = false;
+		bUseGameplayDebugger = false;
+	}
+}